@@ -0,0 +1,79 @@
+#include "AabbKernel.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// -----------------------------------------------------
+// Microbenchmark: SIMD vs scalar car-vs-collider overlap kernel
+//
+//   bilsim_aabb_bench [colliders] [queries]
+// -----------------------------------------------------
+
+int main(int argc, char** argv) {
+
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1u << 16;
+    int queries = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> pos(-1000.f, 1000.f);
+    std::uniform_real_distribution<float> half(0.5f, 20.f);
+
+    std::vector<float> minX(count), maxX(count), minZ(count), maxZ(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        float x = pos(rng), z = pos(rng), hw = half(rng), hl = half(rng);
+        minX[i] = x - hw;
+        maxX[i] = x + hw;
+        minZ[i] = z - hl;
+        maxZ[i] = z + hl;
+    }
+
+    std::vector<Car::AABB> cars(queries);
+    for (auto& c : cars) {
+        float x = pos(rng), z = pos(rng);
+        c = {x - 1.f, x + 1.f, z - 2.f, z + 2.f};
+    }
+
+    std::vector<std::uint64_t> mask((count + 63) / 64);
+    std::vector<std::uint64_t> reference((count + 63) / 64);
+
+    using Kernel = void (*)(const Car::AABB&, const float*, const float*,
+                            const float*, const float*, std::size_t, std::uint64_t*);
+
+    std::uint64_t sink = 0;
+    auto run = [&](Kernel kernel) {
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& c : cars) {
+            kernel(c, minX.data(), maxX.data(), minZ.data(), maxZ.data(), count, mask.data());
+            sink += mask[0];
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() /
+               (double(count) * double(queries));
+    };
+
+    // correctness first: every query must give the same mask
+    for (const auto& c : cars) {
+        aabbOverlapMaskScalar(c, minX.data(), maxX.data(), minZ.data(), maxZ.data(), count, reference.data());
+        aabbOverlapMask(c, minX.data(), maxX.data(), minZ.data(), maxZ.data(), count, mask.data());
+        if (mask != reference) {
+            std::cerr << "Mismatch between SIMD and scalar kernel!\n";
+            return 1;
+        }
+    }
+
+    double scalarNs = run(aabbOverlapMaskScalar);
+    double simdNs = run(aabbOverlapMask);
+
+    std::cout << "colliders:      " << count << "\n"
+              << "queries:        " << queries << "\n"
+              << "kernel:         " << aabbKernelName() << "\n"
+              << "scalar ns/box:  " << scalarNs << "\n"
+              << "simd ns/box:    " << simdNs << "\n"
+              << "speedup:        " << scalarNs / simdNs << "x\n"
+              << "(sink " << (sink & 1) << ")\n";
+
+    return 0;
+}
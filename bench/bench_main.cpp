@@ -0,0 +1,392 @@
+#include "AabbKernel.hpp"
+#include "ObbKernel.hpp"
+#include "Car.hpp"
+#include "Level.hpp"
+#include "Obstacle.hpp"
+#include "RayKernel.hpp"
+#include "VecEnv.hpp"
+#include "World.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// -----------------------------------------------------
+// Microbenchmarks for the core hot paths
+//
+//   bilsim_bench [--filter TEXT] [--min-time SECONDS] [--samples N]
+//                [--json FILE] [--label TEXT]
+//
+// Every case is timed in several samples; a sample repeats the operation
+// until it has run for min-time / samples. The median ns per operation is
+// the number to compare. Results go to stdout and, as JSON, to --json
+// (default bilsim_bench.json) so two commits can be diffed by a script.
+// -----------------------------------------------------
+
+namespace {
+
+struct Options {
+    std::string filter;
+    double minTime = 1.0;
+    int samples = 9;
+    std::string jsonPath = "bilsim_bench.json";
+    std::string label;
+};
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations = 0;
+    double medianNs = 0.0;
+    double minNs = 0.0;
+    double maxNs = 0.0;
+};
+
+// Keeps results alive so the optimizer cannot drop the work
+volatile float sink = 0.f;
+
+using Clock = std::chrono::steady_clock;
+
+// fn(n) runs the operation n times
+Result measure(const std::string& name, const Options& opt,
+               const std::function<void(std::uint64_t)>& fn) {
+    const double sampleSeconds = opt.minTime / opt.samples;
+
+    // grow the batch until one batch takes long enough to time
+    std::uint64_t batch = 1;
+    for (;;) {
+        auto start = Clock::now();
+        fn(batch);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= sampleSeconds || batch >= (1ull << 40)) break;
+        batch = seconds > 0.0 ? std::max(batch * 2, static_cast<std::uint64_t>(batch * sampleSeconds / seconds * 1.1))
+                              : batch * 10;
+    }
+
+    std::vector<double> ns(opt.samples);
+    for (auto& s : ns) {
+        auto start = Clock::now();
+        fn(batch);
+        s = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / double(batch);
+    }
+    std::sort(ns.begin(), ns.end());
+
+    return {name, batch * opt.samples, ns[ns.size() / 2], ns.front(), ns.back()};
+}
+
+// Default level plus `fences` random fences in a square sized so the
+// density (and the collisions per tick) stays about the same
+LevelFile makeLevel(std::size_t fences) {
+    std::string text(defaultLevelText());
+    std::ostringstream extra;
+
+    const float half = 200.f * std::sqrt(std::max(1.f, fences / 400.f));
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos(-half, half);
+    std::uniform_real_distribution<float> size(0.5f, 4.f);
+    for (std::size_t i = 0; i < fences; ++i) {
+        float x = pos(rng), z = pos(rng);
+        if (std::abs(x) < 10.f && std::abs(z) < 10.f) x += 20.f; // keep the start free
+        extra << "fence " << x << ' ' << z << ' ' << size(rng) << ' ' << size(rng) << '\n';
+    }
+
+    LevelFile level;
+    level.loadText(text + "\n" + extra.str());
+    return level;
+}
+
+InputState circling() {
+    InputState in;
+    in.accelerate = true;
+    in.turnLeft = true;
+    return in;
+}
+
+// JSON string body: quotes and backslashes escaped, control characters
+// as \u00XX (a label could hold a newline)
+void writeEscaped(std::ofstream& out, const std::string& s) {
+    static constexpr char Hex[] = "0123456789abcdef";
+    for (char c : s) {
+        const auto u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') out << '\\' << c;
+        else if (u < 0x20) out << "\\u00" << Hex[u >> 4] << Hex[u & 15];
+        else out << c;
+    }
+}
+
+bool writeJson(const std::string& path, const Options& opt, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    out << "{\n  \"label\": \"";
+    writeEscaped(out, opt.label);
+    out << "\",\n"
+        << "  \"kernel\": \"" << aabbKernelName() << "\",\n"
+        << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        out << "    {\"name\": \"";
+        writeEscaped(out, r.name);
+        out << "\", \"iterations\": " << r.iterations
+            << ", \"median_ns\": " << r.medianNs << ", \"min_ns\": " << r.minNs
+            << ", \"max_ns\": " << r.maxNs << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    out.close();
+    return static_cast<bool>(out);
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!v) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        ++i;
+        if (arg == "--filter") opt.filter = v;
+        else if (arg == "--min-time") opt.minTime = std::max(0.01, std::atof(v));
+        else if (arg == "--samples") opt.samples = std::max(1, std::atoi(v));
+        else if (arg == "--json") opt.jsonPath = v;
+        else if (arg == "--label") opt.label = v;
+        else {
+            std::cerr << "Unknown argument: " << arg << "\n"
+                      << "Usage: bilsim_bench [--filter TEXT] [--min-time SECONDS] [--samples N]"
+                         " [--json FILE] [--label TEXT]\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+// -----------------------------------------------------
+// MAIN
+// -----------------------------------------------------
+
+int main(int argc, char** argv) {
+
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 1;
+
+    const float dt = 1.f / 60.f;
+    std::vector<std::pair<std::string, std::function<Result(const std::string&)>>> cases;
+
+    auto add = [&](const std::string& name, std::function<void(std::uint64_t)> fn) {
+        cases.emplace_back(name, [fn, &opt](const std::string& n) { return measure(n, opt, fn); });
+    };
+
+    // --- Car ---
+    add("car/update", [&](std::uint64_t n) {
+        Car car;
+        const InputState in = circling();
+        for (std::uint64_t i = 0; i < n; ++i) car.update(dt, in);
+        sink = car.position().x;
+    });
+
+    // --- World::update at several collider counts ---
+    for (std::size_t fences : {0u, 1000u, 10000u, 100000u}) {
+        auto level = std::make_shared<LevelFile>(makeLevel(fences));
+        auto world = std::make_shared<World>(level->view());
+        const std::string name = "world/update/" + std::to_string(world->colliders().size()) + "_colliders";
+
+        add(name, [world, dt](std::uint64_t n) {
+            const InputState in = circling();
+            for (std::uint64_t i = 0; i < n; ++i) world->update(dt, in);
+            sink = world->car().position().x;
+        });
+    }
+
+    {
+        auto world = std::make_shared<World>();
+        world->spawnTraffic(1000, 7);
+        add("world/update/1000_traffic", [world, dt](std::uint64_t n) {
+            const InputState in = circling();
+            for (std::uint64_t i = 0; i < n; ++i) world->update(dt, in);
+            sink = world->traffic().position(0).x;
+        });
+    }
+
+    // --- Reset (snapshot restore) and full rebuild ---
+    for (std::size_t fences : {0u, 10000u}) {
+        auto level = std::make_shared<LevelFile>(makeLevel(fences));
+        auto world = std::make_shared<World>(level->view());
+        const std::string suffix = std::to_string(world->colliders().size()) + "_colliders";
+
+        world->update(dt, circling());
+        add("world/reset/" + suffix, [world](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) world->reset();
+            sink = world->car().position().x;
+        });
+
+        add("world/load/" + suffix, [world, level](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) world->load(level->view());
+            sink = static_cast<float>(world->colliders().size());
+        });
+    }
+
+    // --- Training env: one op = one step of every world in the batch ---
+    for (auto [batch, lidarRays] : {std::pair<std::size_t, std::uint32_t>{1, 0}, {4096, 0}, {4096, 64}}) {
+        VecEnv::Config config;
+        config.batch = batch;
+        config.lidarRays = lidarRays;
+        auto env = std::make_shared<VecEnv>(LevelFile::defaultLevel().view(), config);
+        auto actions = std::make_shared<std::vector<std::uint8_t>>(batch);
+        for (std::size_t i = 0; i < batch; ++i) {
+            (*actions)[i] = VecEnv::Accelerate | ((i & 1) ? VecEnv::TurnLeft : VecEnv::TurnRight);
+        }
+
+        add("vec_env/step/" + std::to_string(batch) + (lidarRays ? "/lidar_64" : ""), [env, actions](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) env->step(*actions);
+            sink = env->observations()[0];
+        });
+    }
+
+    // --- Lidar: one op = a 64 ray fan from one car; 300 cars = 300 ops ---
+    {
+        auto level = std::make_shared<LevelFile>(makeLevel(10000));
+        auto world = std::make_shared<World>(level->view());
+        const std::string suffix = std::to_string(world->colliders().size()) + "_colliders";
+
+        // spots spread over the level, so traversals differ
+        auto spots = std::make_shared<std::vector<Vec2>>(256);
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> pos(-1000.f, 1000.f);
+        for (auto& p : *spots) p = {pos(rng), pos(rng)};
+
+        add("lidar/bvh/64_rays/" + suffix, [world, spots](std::uint64_t n) {
+            RayFan rays;
+            float acc = 0.f;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                const Vec2 p = (*spots)[i & 255];
+                rays.set(p.x, p.z, float(i & 7), 6.2831853f, 64, 50.f);
+                world->castRays(rays);
+                acc += rays.t[i & 63];
+            }
+            sink = acc;
+        });
+
+        // the same fans against every collider, for comparison
+        add("lidar/brute_force/64_rays/" + suffix, [world, spots](std::uint64_t n) {
+            const ColliderStore& colliders = world->colliders();
+            RayFan rays;
+            alignas(32) float tEnter[RayFan::MaxRays];
+            float acc = 0.f;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                const Vec2 p = (*spots)[i & 255];
+                rays.set(p.x, p.z, float(i & 7), 6.2831853f, 64, 50.f);
+                for (std::uint32_t c = 0; c < colliders.size(); ++c) {
+                    if (colliders.kind(c) != ColliderKind::Obstacle || !colliders.isActive(c)) continue;
+                    std::uint64_t mask = raySlabMask(rays, colliders.bounds(c), tEnter);
+                    for (; mask; mask &= mask - 1) {
+                        const int k = std::countr_zero(mask);
+                        rays.t[k] = tEnter[k];
+                    }
+                }
+                acc += rays.t[i & 63];
+            }
+            sink = acc;
+        });
+    }
+
+    // --- Pickup counters ---
+    {
+        auto world = std::make_shared<World>();
+        add("world/pickup_counters", [world](std::uint64_t n) {
+            // volatile pointer: re-read every iteration instead of hoisting the calls
+            World* volatile w = world.get();
+            int total = 0;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                total += w->totalPickups() + w->collectedPickups();
+            }
+            sink = static_cast<float>(total);
+        });
+    }
+
+    // --- Narrowphase: Obstacle::onCarOverlap ---
+    add("obstacle/on_car_overlap", [](std::uint64_t n) {
+        Obstacle wall(0.f, 0.f, 4.f, 1.f);
+        Car car;
+        float acc = 0.f;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            // alternate sides so both push directions run
+            car.setPosition((i & 1) ? 1.5f : -1.5f, (i & 2) ? 1.f : -1.f);
+            wall.onCarOverlap(car);
+            acc += car.position().z;
+        }
+        sink = acc;
+    });
+
+    // --- Collision kernel (per 64k colliders) ---
+    {
+        const std::size_t count = 1u << 16;
+        auto boxes = std::make_shared<std::vector<float>>(4 * count);
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> pos(-1000.f, 1000.f);
+        for (std::size_t i = 0; i < count; ++i) {
+            float x = pos(rng), z = pos(rng);
+            (*boxes)[i] = x - 2.f;
+            (*boxes)[count + i] = x + 2.f;
+            (*boxes)[2 * count + i] = z - 2.f;
+            (*boxes)[3 * count + i] = z + 2.f;
+        }
+        auto mask = std::make_shared<std::vector<std::uint64_t>>((count + 63) / 64);
+
+        auto kernelCase = [boxes, mask, count](auto kernel) {
+            return [=](std::uint64_t n) {
+                const float* b = boxes->data();
+                for (std::uint64_t i = 0; i < n; ++i) {
+                    Car::AABB car{-1.f, 1.f, float(i % 100) - 2.f, float(i % 100) + 2.f};
+                    kernel(car, b, b + count, b + 2 * count, b + 3 * count, count, mask->data());
+                }
+                sink = static_cast<float>((*mask)[0] & 1);
+            };
+        };
+        add("aabb_kernel/simd/65536", kernelCase(aabbOverlapMask));
+        add("aabb_kernel/scalar/65536", kernelCase(aabbOverlapMaskScalar));
+
+        // rotated car: AABB prefilter + SAT per group with a hit
+        auto obbCase = [boxes, mask, count](auto kernel) {
+            return [=](std::uint64_t n) {
+                const float* b = boxes->data();
+                for (std::uint64_t i = 0; i < n; ++i) {
+                    Car::OBB car{0.f, float(i % 100), 0.6f, 0.8f, 1.f, 2.f};
+                    kernel(car, b, b + count, b + 2 * count, b + 3 * count, count, mask->data());
+                }
+                sink = static_cast<float>((*mask)[0] & 1);
+            };
+        };
+        add("obb_kernel/simd/65536", obbCase(obbOverlapMask));
+        add("obb_kernel/scalar/65536", obbCase(obbOverlapMaskScalar));
+    }
+
+    // --- Run ---
+    std::vector<Result> results;
+    std::cout << "median ns/op  (min .. max)  case\n";
+    for (const auto& [name, run] : cases) {
+        if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) continue;
+
+        Result r = run(name);
+        std::cout << r.medianNs << "  (" << r.minNs << " .. " << r.maxNs << ")  " << r.name << "\n";
+        results.push_back(r);
+    }
+
+    if (!writeJson(opt.jsonPath, opt, results)) {
+        std::cerr << "Failed to write " << opt.jsonPath << "\n";
+        return 1;
+    }
+    std::cout << "results written to " << opt.jsonPath << "\n";
+
+    return 0;
+}
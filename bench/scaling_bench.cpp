@@ -0,0 +1,182 @@
+#include "Level.hpp"
+#include "LevelGenerator.hpp"
+#include "World.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// -----------------------------------------------------
+// Scaling benchmark: World::update on generated levels
+//
+//   bilsim_scaling_bench [--max N] [--ticks N] [--seed N] [--traffic N]
+//                        [--json FILE] [--label TEXT]
+//
+// Generates levels with 10, 100, ... up to --max colliders (default
+// 1,000,000) at the same density and drives the car around each one.
+// Reports ns per World::update (median of 5 samples), the world's memory
+// per collider and the build time. With the broadphase working, ns/tick
+// stays flat as the level grows; memory per collider should not grow.
+// -----------------------------------------------------
+
+namespace {
+
+struct Options {
+    std::size_t max = 1000000;
+    std::size_t ticks = 20000;
+    std::uint32_t seed = 1;
+    std::size_t traffic = 0;
+    std::string jsonPath = "bilsim_scaling.json";
+    std::string label;
+};
+
+struct Row {
+    std::size_t colliders = 0;
+    double nsPerTick = 0.0;
+    double bytesPerCollider = 0.0;
+    double buildMs = 0.0;
+    int contacts = 0;
+};
+
+volatile float sink = 0.f;
+
+using Clock = std::chrono::steady_clock;
+
+// Full throttle, turning left for 2 s out of every 5: the car sweeps
+// wide loops away from the start and runs into fences regularly
+InputState drive(std::size_t tick) {
+    InputState in;
+    in.accelerate = true;
+    in.turnLeft = tick % 300 < 120;
+    return in;
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            return (i + 1 < argc) ? argv[++i] : nullptr;
+        };
+
+        const char* v = nullptr;
+        if (arg == "--max" && (v = value())) opt.max = std::strtoull(v, nullptr, 10);
+        else if (arg == "--ticks" && (v = value())) opt.ticks = std::strtoull(v, nullptr, 10);
+        else if (arg == "--seed" && (v = value())) opt.seed = std::uint32_t(std::strtoul(v, nullptr, 10));
+        else if (arg == "--traffic" && (v = value())) opt.traffic = std::strtoull(v, nullptr, 10);
+        else if (arg == "--json" && (v = value())) opt.jsonPath = v;
+        else if (arg == "--label" && (v = value())) opt.label = v;
+        else {
+            std::cerr << "Unknown or incomplete argument: " << arg << "\n"
+                      << "Usage: bilsim_scaling_bench [--max N] [--ticks N] [--seed N] [--traffic N]"
+                         " [--json FILE] [--label TEXT]\n";
+            return false;
+        }
+    }
+    return opt.ticks >= 5;
+}
+
+Row measure(std::size_t colliders, const Options& opt) {
+    const LevelGenParams params = stressLevelParams(colliders, opt.seed);
+
+    Row row;
+
+    const auto buildStart = Clock::now();
+    std::vector<std::byte> bytes;
+    generateLevel(params, bytes);
+    LevelFile level;
+    level.load(std::move(bytes));
+    World world(level.view());
+    if (opt.traffic > 0) world.spawnTraffic(opt.traffic, opt.seed);
+    row.buildMs = std::chrono::duration<double, std::milli>(Clock::now() - buildStart).count();
+
+    row.colliders = world.colliders().size();
+    row.bytesPerCollider = double(world.memoryUsage()) / double(row.colliders);
+
+    const float dt = 1.f / 60.f;
+    const std::size_t perSample = opt.ticks / 5;
+    std::vector<double> samples;
+    std::size_t tick = 0;
+
+    for (int s = 0; s < 5; ++s) {
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < perSample; ++i, ++tick) {
+            world.update(dt, drive(tick));
+            for (const auto& e : world.events()) {
+                row.contacts += e.type == WorldEvent::Type::CollisionContact;
+            }
+        }
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / double(perSample));
+    }
+    std::sort(samples.begin(), samples.end());
+    row.nsPerTick = samples[samples.size() / 2];
+
+    sink = world.car().position().x;
+    return row;
+}
+
+// JSON string body, escaped as in bilsim_bench
+void writeEscaped(std::ofstream& out, const std::string& s) {
+    static constexpr char Hex[] = "0123456789abcdef";
+    for (char c : s) {
+        const auto u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') out << '\\' << c;
+        else if (u < 0x20) out << "\\u00" << Hex[u >> 4] << Hex[u & 15];
+        else out << c;
+    }
+}
+
+bool writeJson(const std::string& path, const Options& opt, const std::vector<Row>& rows) {
+    std::ofstream out(path);
+    out << "{\n  \"label\": \"";
+    writeEscaped(out, opt.label);
+    out << "\",\n"
+        << "  \"traffic\": " << opt.traffic << ",\n"
+        << "  \"results\": [\n";
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const auto& r = rows[i];
+        out << "    {\"colliders\": " << r.colliders << ", \"ns_per_tick\": " << r.nsPerTick
+            << ", \"bytes_per_collider\": " << r.bytesPerCollider << ", \"build_ms\": " << r.buildMs
+            << "}" << (i + 1 < rows.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    out.close();
+    return static_cast<bool>(out);
+}
+
+}
+
+// -----------------------------------------------------
+// MAIN
+// -----------------------------------------------------
+
+int main(int argc, char** argv) {
+
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 1;
+
+    std::vector<Row> rows;
+    std::cout << "colliders   ns/tick   bytes/collider   build ms   contacts\n";
+    for (std::size_t n = 10; n <= opt.max; n *= 10) {
+        const Row r = measure(n, opt);
+        std::cout << r.colliders << "   " << r.nsPerTick << "   " << r.bytesPerCollider << "   "
+                  << r.buildMs << "   " << r.contacts << "\n";
+        rows.push_back(r);
+    }
+
+    if (rows.size() > 1) {
+        std::cout << "ns/tick, largest vs smallest level: "
+                  << rows.back().nsPerTick / rows.front().nsPerTick << "x\n";
+    }
+
+    if (!writeJson(opt.jsonPath, opt, rows)) {
+        std::cerr << "Failed to write " << opt.jsonPath << "\n";
+        return 1;
+    }
+    std::cout << "results written to " << opt.jsonPath << "\n";
+    return 0;
+}
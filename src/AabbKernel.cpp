@@ -0,0 +1,94 @@
+#include "AabbKernel.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BILSIM_KERNEL_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BILSIM_KERNEL_SSE2 1
+#endif
+
+namespace {
+
+inline bool overlaps(const Car::AABB& a, float minX, float maxX, float minZ, float maxZ) {
+    return a.minX <= maxX && a.maxX >= minX &&
+           a.minZ <= maxZ && a.maxZ >= minZ;
+}
+
+void clearMask(std::size_t count, std::uint64_t* outMask) {
+    for (std::size_t w = 0; w < (count + 63) / 64; ++w) outMask[w] = 0;
+}
+
+void scalarRange(const Car::AABB& box,
+                 const float* minX, const float* maxX,
+                 const float* minZ, const float* maxZ,
+                 std::size_t begin, std::size_t end, std::uint64_t* outMask) {
+    for (std::size_t i = begin; i < end; ++i) {
+        if (overlaps(box, minX[i], maxX[i], minZ[i], maxZ[i])) {
+            outMask[i >> 6] |= std::uint64_t{1} << (i & 63);
+        }
+    }
+}
+
+}
+
+void aabbOverlapMaskScalar(const Car::AABB& box,
+                           const float* minX, const float* maxX,
+                           const float* minZ, const float* maxZ,
+                           std::size_t count, std::uint64_t* outMask) {
+    clearMask(count, outMask);
+    scalarRange(box, minX, maxX, minZ, maxZ, 0, count, outMask);
+}
+
+void aabbOverlapMask(const Car::AABB& box,
+                     const float* minX, const float* maxX,
+                     const float* minZ, const float* maxZ,
+                     std::size_t count, std::uint64_t* outMask) {
+    clearMask(count, outMask);
+    std::size_t i = 0;
+
+#if defined(BILSIM_KERNEL_AVX2)
+    const __m256 cMinX = _mm256_set1_ps(box.minX);
+    const __m256 cMaxX = _mm256_set1_ps(box.maxX);
+    const __m256 cMinZ = _mm256_set1_ps(box.minZ);
+    const __m256 cMaxZ = _mm256_set1_ps(box.maxZ);
+
+    // 8 lanes; i stays a multiple of 8, so a group never straddles two words
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_and_ps(_mm256_cmp_ps(cMinX, _mm256_loadu_ps(maxX + i), _CMP_LE_OQ),
+                                 _mm256_cmp_ps(cMaxX, _mm256_loadu_ps(minX + i), _CMP_GE_OQ));
+        __m256 z = _mm256_and_ps(_mm256_cmp_ps(cMinZ, _mm256_loadu_ps(maxZ + i), _CMP_LE_OQ),
+                                 _mm256_cmp_ps(cMaxZ, _mm256_loadu_ps(minZ + i), _CMP_GE_OQ));
+        auto bits = static_cast<std::uint64_t>(_mm256_movemask_ps(_mm256_and_ps(x, z)));
+        outMask[i >> 6] |= bits << (i & 63);
+    }
+#elif defined(BILSIM_KERNEL_SSE2)
+    const __m128 cMinX = _mm_set1_ps(box.minX);
+    const __m128 cMaxX = _mm_set1_ps(box.maxX);
+    const __m128 cMinZ = _mm_set1_ps(box.minZ);
+    const __m128 cMaxZ = _mm_set1_ps(box.maxZ);
+
+    // 4 lanes; i stays a multiple of 4, so a group never straddles two words
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_and_ps(_mm_cmple_ps(cMinX, _mm_loadu_ps(maxX + i)),
+                              _mm_cmpge_ps(cMaxX, _mm_loadu_ps(minX + i)));
+        __m128 z = _mm_and_ps(_mm_cmple_ps(cMinZ, _mm_loadu_ps(maxZ + i)),
+                              _mm_cmpge_ps(cMaxZ, _mm_loadu_ps(minZ + i)));
+        auto bits = static_cast<std::uint64_t>(_mm_movemask_ps(_mm_and_ps(x, z)));
+        outMask[i >> 6] |= bits << (i & 63);
+    }
+#endif
+
+    // tail (and the whole range on non-x86 targets)
+    scalarRange(box, minX, maxX, minZ, maxZ, i, count, outMask);
+}
+
+const char* aabbKernelName() {
+#if defined(BILSIM_KERNEL_AVX2)
+    return "avx2";
+#elif defined(BILSIM_KERNEL_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
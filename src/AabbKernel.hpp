@@ -0,0 +1,31 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_AABBKERNEL_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_AABBKERNEL_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Car.hpp"
+
+// Car box vs packed collider boxes (same test as World::intersects).
+//
+// Bit k of outMask[k / 64] is set when box overlaps collider k.
+// outMask must hold (count + 63) / 64 words; it is fully overwritten.
+//
+// aabbOverlapMask tests 8 boxes per step with AVX2 (BILSIM_AVX2 build),
+// 4 with SSE2, and falls back to aabbOverlapMaskScalar elsewhere.
+// All paths give bit-identical masks (the compares are exact).
+void aabbOverlapMask(const Car::AABB& box,
+                     const float* minX, const float* maxX,
+                     const float* minZ, const float* maxZ,
+                     std::size_t count, std::uint64_t* outMask);
+
+void aabbOverlapMaskScalar(const Car::AABB& box,
+                           const float* minX, const float* maxX,
+                           const float* minZ, const float* maxZ,
+                           std::size_t count, std::uint64_t* outMask);
+
+// "avx2", "sse2" or "scalar"
+const char* aabbKernelName();
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_AABBKERNEL_HPP
@@ -0,0 +1,34 @@
+#include "AssetLoader.hpp"
+#include <algorithm>
+#include <iterator>
+
+AssetLoader::AssetLoader(unsigned threads)
+    : pool_(std::make_unique<ThreadPool>(threads)) {}
+
+AssetLoader::~AssetLoader() {
+    // let running loads finish before the queue they deliver into goes away
+    pool_.reset();
+}
+
+void AssetLoader::deliver(std::function<void()> callback) {
+    std::lock_guard lock(mutex_);
+    ready_.push_back(std::move(callback));
+}
+
+std::size_t AssetLoader::poll(std::size_t maxCount) {
+    std::vector<std::function<void()>> batch;
+    {
+        std::lock_guard lock(mutex_);
+        const std::size_t n = std::min(maxCount, ready_.size());
+        batch.assign(std::make_move_iterator(ready_.begin()),
+                     std::make_move_iterator(ready_.begin() + static_cast<std::ptrdiff_t>(n)));
+        ready_.erase(ready_.begin(), ready_.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+
+    // outside the lock: a callback may request more assets
+    for (auto& callback : batch) {
+        callback();
+        pending_.fetch_sub(1, std::memory_order_release);
+    }
+    return batch.size();
+}
@@ -0,0 +1,74 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_ASSETLOADER_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_ASSETLOADER_HPP
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+// Loads assets in the background and hands them back to one thread.
+//
+//   loader.load<Model>([] { return parse("x.obj"); },         // worker
+//                      [&](Model m) { scene.add(m.root); });  // poll()ing thread
+//
+// work() runs on the loader's pool; done() runs later, inside poll(), on
+// whichever thread calls it (the render thread, so everything touching the
+// scene or the GL context stays there). Results come back in the order they
+// finish, not the order they were requested.
+class AssetLoader {
+public:
+    explicit AssetLoader(unsigned threads = std::thread::hardware_concurrency());
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    template<class T>
+    void load(std::function<T()> work, std::function<void(T)> done) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_->submit([this, work = std::move(work), done = std::move(done)] {
+            std::shared_ptr<T> result;
+            try {
+                result = std::make_shared<T>(work());
+            } catch (...) {
+                // no done() for this asset; the caller sees it in failed()
+                failed_.fetch_add(1, std::memory_order_relaxed);
+                pending_.fetch_sub(1, std::memory_order_release);
+                return;
+            }
+            deliver([done, result] { done(std::move(*result)); });
+        });
+    }
+
+    // Runs up to maxCount finished done() callbacks on the calling thread
+    // and returns how many ran
+    std::size_t poll(std::size_t maxCount = SIZE_MAX);
+
+    // Requested but not delivered by poll() yet
+    std::size_t pending() const { return pending_.load(std::memory_order_acquire); }
+    bool idle() const { return pending() == 0; }
+
+    // work() calls that threw
+    std::size_t failed() const { return failed_.load(std::memory_order_relaxed); }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::function<void()>> ready_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<std::size_t> failed_{0};
+
+    // last member: its destructor finishes the running work while ready_ is
+    // still alive
+    std::unique_ptr<ThreadPool> pool_;
+
+    void deliver(std::function<void()> callback);
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_ASSETLOADER_HPP
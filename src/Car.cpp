@@ -7,21 +7,39 @@ Car::Car() = default;
 void Car::reset() {
     position_ = {0.f, 0.f};
     rotation_ = 0.f;
+    forwardX_ = 0.f;
+    forwardZ_ = 1.f;
     speed_ = 0.f;
     visualScale_ = 1.f;
+    version_++;
+}
 
+void Car::restoreFrom(const Car& other) {
+    const std::uint32_t version = version_;
+    *this = other;
+    version_ = version + 1;
 }
 
 void Car::setPosition(float x, float z) {
+    if (position_.x == x && position_.z == z) return;
     position_ = {x, z};
+    version_++;
 }
 
 void Car::setRotation(float angle) {
+    if (rotation_ == angle) return;
     rotation_ = angle;
+    forwardX_ = std::sin(angle);
+    forwardZ_ = std::cos(angle);
+    version_++;
 }
 
 void Car::update(float dt, const InputState& input) {
 
+    const Vec2 oldPosition = position_;
+    const float oldRotation = rotation_;
+    const float oldScale = visualScale_;
+
     // update timers
     if (boostTimer_ > 0) {
         boostTimer_ -= dt;
@@ -63,9 +81,19 @@ void Car::update(float dt, const InputState& input) {
         if (input.turnRight) rotation_ -= turnSpeed_ * dt;
     }
 
+    if (rotation_ != oldRotation) {
+        forwardX_ = std::sin(rotation_);
+        forwardZ_ = std::cos(rotation_);
+    }
+
     // movement
-    position_.x += std::sin(rotation_) * speed_ * dt;
-    position_.z += std::cos(rotation_) * speed_ * dt;
+    position_.x += forwardX_ * speed_ * dt;
+    position_.z += forwardZ_ * speed_ * dt;
+
+    if (position_.x != oldPosition.x || position_.z != oldPosition.z ||
+        rotation_ != oldRotation || visualScale_ != oldScale) {
+        version_++;
+    }
 }
 
 Car::AABB Car::bounds() const {
@@ -76,6 +104,25 @@ Car::AABB Car::bounds() const {
         position_.z + halfLength_
     };
 }
+Car::OBB Car::orientedBounds() const {
+    return {position_.x, position_.z, forwardX_, forwardZ_, halfWidth_, halfLength_};
+}
+
+// the side axis is (forwardZ, -forwardX)
+float Car::OBB::extentX() const {
+    return halfW * std::abs(forwardZ) + halfL * std::abs(forwardX);
+}
+
+float Car::OBB::extentZ() const {
+    return halfW * std::abs(forwardX) + halfL * std::abs(forwardZ);
+}
+
+Car::AABB Car::OBB::enclosing() const {
+    const float ex = extentX();
+    const float ez = extentZ();
+    return {x - ex, x + ex, z - ez, z + ez};
+}
+
 void Car::applySpeedBoost() {
     maxSpeed_ = 50.f;
     acceleration_ = 25.f;
@@ -89,5 +136,6 @@ void Car::applySizeChange() {
         enlarged_ = true;
         visualScale_ = 2.0f;
         sizeTimer_ = 6.f; // lasts 6 seconds
+        version_++;
     }
 }
@@ -2,6 +2,7 @@
 #define BIL_SIMULATOR_JOHN_MITCHEL_CAR_HPP
 
 #pragma once
+#include <cstdint>
 #include "InputState.hpp"
 
 struct Vec2 {
@@ -23,6 +24,10 @@ public:
     void setRotation(float angle);
     void setSpeed(float s) { speed_ = s; }
 
+    // Takes over other's state. Counts as a change: the version keeps
+    // counting up instead of jumping back to other's.
+    void restoreFrom(const Car& other);
+
 
     Vec2 position() const { return position_; }
     float rotation() const { return rotation_; }
@@ -33,18 +38,45 @@ public:
         float minZ, maxZ;
     };
 
+    // Axis-aligned with the world, ignores rotation()
     AABB bounds() const;
 
+    // The car's box as it actually sits: centre, forward direction
+    // (sin, cos of the rotation) and half extents across / along it
+    struct OBB {
+        float x, z;
+        float forwardX, forwardZ;
+        float halfW, halfL;
+
+        // the rotation is a multiple of 90 degrees (then it equals bounds())
+        bool axisAligned() const { return forwardX == 0.f || forwardZ == 0.f; }
+        // smallest world-aligned box around it (what the broadphase queries)
+        // and its half extents
+        AABB enclosing() const;
+        float extentX() const;
+        float extentZ() const;
+    };
+
+    OBB orientedBounds() const;
+
     // ---- PUBLIC GETTERS (required for obstacle + main.cpp) ----
     float getHalfWidth() const { return halfWidth_; }
     float getHalfLength() const { return halfLength_; }
     float getVisualScale() const { return visualScale_; }
 
+    // Bumped whenever position, rotation or visual scale change, i.e. what
+    // the car mesh shows. A renderer that remembers it can skip parked cars.
+    std::uint32_t version() const { return version_; }
+
 private:
     Vec2 position_{};
     float rotation_ = 0.f;
     float speed_ = 0.f;
 
+    // sin/cos of rotation_, kept with it so collision tests don't recompute them
+    float forwardX_ = 0.f;
+    float forwardZ_ = 1.f;
+
     float boostTimer_ = 0.f;
     float sizeTimer_ = 0.f;
     bool enlarged_ = false;
@@ -60,6 +92,8 @@ private:
 
     // ---- VISUAL SCALE FIELD (used to scale the mesh) ----
     float visualScale_ = 1.f;
+
+    std::uint32_t version_ = 0;
 };
 
 #endif // BIL_SIMULATOR_JOHN_MITCHEL_CAR_HPP
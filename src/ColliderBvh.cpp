@@ -0,0 +1,152 @@
+#include "ColliderBvh.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+GameObject::AABB merge(const GameObject::AABB& a, const GameObject::AABB& b) {
+    return {std::min(a.minX, b.minX), std::max(a.maxX, b.maxX),
+            std::min(a.minZ, b.minZ), std::max(a.maxZ, b.maxZ)};
+}
+
+// squared distance from (x, z) to the box centre, for near-first ordering
+float distance2(const GameObject::AABB& box, float x, float z) {
+    const float dx = (box.minX + box.maxX) * 0.5f - x;
+    const float dz = (box.minZ + box.maxZ) * 0.5f - z;
+    return dx * dx + dz * dz;
+}
+
+// median splits keep the depth near log2(n / LeafSize); 64 levels is
+// far beyond any level that fits in memory
+constexpr std::size_t StackSize = 64;
+
+}
+
+void ColliderBvh::clear() {
+    nodes_.clear();
+    boxes_.clear();
+    ids_.clear();
+}
+
+std::size_t ColliderBvh::memoryUsage() const {
+    return nodes_.capacity() * sizeof(Node) +
+           boxes_.capacity() * sizeof(GameObject::AABB) +
+           ids_.capacity() * sizeof(std::uint32_t) +
+           centers_.capacity() * sizeof(float);
+}
+
+void ColliderBvh::build(const ColliderStore& colliders) {
+    clear();
+
+    centers_.resize(colliders.size() * 2);
+    for (std::uint32_t i = 0; i < colliders.size(); ++i) {
+        if (colliders.kind(i) != ColliderKind::Obstacle) continue;
+        const GameObject::AABB box = colliders.bounds(i);
+        centers_[i * 2] = (box.minX + box.maxX) * 0.5f;
+        centers_[i * 2 + 1] = (box.minZ + box.maxZ) * 0.5f;
+        ids_.push_back(i);
+    }
+    if (ids_.empty()) return;
+
+    // n leaves at most, so at most 2n - 1 nodes: split() never reallocates
+    nodes_.reserve(ids_.size() * 2);
+    nodes_.push_back({{}, 0, static_cast<std::uint32_t>(ids_.size())});
+    split(0);
+
+    boxes_.resize(ids_.size());
+    for (std::size_t i = 0; i < ids_.size(); ++i) boxes_[i] = colliders.bounds(ids_[i]);
+
+    // children always come after their parent, so one backwards pass
+    // computes every box from the bottom up
+    for (std::size_t n = nodes_.size(); n-- > 0;) {
+        Node& node = nodes_[n];
+        if (node.count > 0) {
+            node.box = boxes_[node.first];
+            for (std::uint32_t i = 1; i < node.count; ++i) node.box = merge(node.box, boxes_[node.first + i]);
+        } else {
+            node.box = merge(nodes_[node.first].box, nodes_[node.first + 1].box);
+        }
+    }
+}
+
+void ColliderBvh::split(std::uint32_t index) {
+    const std::uint32_t first = nodes_[index].first;
+    const std::uint32_t count = nodes_[index].count;
+    if (count <= LeafSize) return;
+
+    const auto begin = ids_.begin() + first;
+    const auto end = begin + count;
+
+    float minX = centers_[*begin * 2], maxX = minX;
+    float minZ = centers_[*begin * 2 + 1], maxZ = minZ;
+    for (auto it = begin + 1; it != end; ++it) {
+        minX = std::min(minX, centers_[*it * 2]);
+        maxX = std::max(maxX, centers_[*it * 2]);
+        minZ = std::min(minZ, centers_[*it * 2 + 1]);
+        maxZ = std::max(maxZ, centers_[*it * 2 + 1]);
+    }
+
+    // median of the centres along the wider axis: balanced even when the
+    // boxes bunch up (a fence line, a field of cones)
+    const std::size_t axis = maxX - minX >= maxZ - minZ ? 0 : 1;
+    const std::uint32_t half = count / 2;
+    std::nth_element(begin, begin + half, end, [&](std::uint32_t a, std::uint32_t b) {
+        return centers_[a * 2 + axis] < centers_[b * 2 + axis];
+    });
+
+    const auto left = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back({{}, first, half});
+    nodes_.push_back({{}, first + half, count - half});
+    nodes_[index].first = left;
+    nodes_[index].count = 0;
+
+    split(left);
+    split(left + 1);
+}
+
+void ColliderBvh::castRays(const ColliderStore& colliders, RayFan& rays, std::uint32_t* hits) const {
+    if (hits) std::fill(hits, hits + rays.count, NoHit);
+    if (nodes_.empty() || rays.count == 0) return;
+
+    alignas(32) float tEnter[RayFan::MaxRays];
+
+    // (node, rays that entered its parent)
+    std::uint32_t stackNode[StackSize];
+    std::uint64_t stackMask[StackSize];
+    std::size_t top = 0;
+    stackNode[top] = 0;
+    stackMask[top++] = ~std::uint64_t{0};
+
+    while (top > 0) {
+        --top;
+        const Node& node = nodes_[stackNode[top]];
+        // t may have shrunk since the node was pushed, so test it here
+        const std::uint64_t mask = raySlabMask(rays, node.box, tEnter) & stackMask[top];
+        if (mask == 0) continue;
+
+        if (node.count == 0) {
+            std::uint32_t near = node.first;
+            std::uint32_t far = node.first + 1;
+            if (distance2(nodes_[far].box, rays.originX, rays.originZ) <
+                distance2(nodes_[near].box, rays.originX, rays.originZ)) {
+                std::swap(near, far);
+            }
+            stackNode[top] = far;
+            stackMask[top++] = mask;
+            stackNode[top] = near;
+            stackMask[top++] = mask;
+            continue;
+        }
+
+        for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+            if (!colliders.isActive(ids_[i])) continue;
+            std::uint64_t hit = raySlabMask(rays, boxes_[i], tEnter) & mask;
+            while (hit) {
+                const int k = std::countr_zero(hit);
+                hit &= hit - 1;
+                rays.t[k] = tEnter[k];
+                if (hits) hits[k] = ids_[i];
+            }
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_COLLIDERBVH_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_COLLIDERBVH_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ColliderStore.hpp"
+#include "RayKernel.hpp"
+
+// Bounding volume hierarchy over the obstacle boxes of a ColliderStore, for
+// ray casts (lidar sensors). Pickups are not in it: sensors see walls,
+// fences and gates.
+//
+// Built once per level. Opened gates stay in the tree and are skipped at
+// the leaves through the store's active bits, so opening a gate or a
+// reset closing it again needs no rebuild.
+//
+// castRays() traverses with the whole fan at once: every node is tested
+// against all rays with the batched slab kernel (RayKernel.hpp), and
+// children are visited near-first, so far nodes are culled by hits
+// already found.
+class ColliderBvh {
+public:
+    static constexpr std::uint32_t NoHit = 0xFFFFFFFFu;
+
+    void build(const ColliderStore& colliders);
+    void clear();
+
+    // Shortens rays.t[k] to the nearest active obstacle hit by ray k and
+    // writes its collider index to hits[k] (NoHit if the ray is clear;
+    // hits may be null)
+    void castRays(const ColliderStore& colliders, RayFan& rays, std::uint32_t* hits) const;
+
+    std::size_t nodeCount() const { return nodes_.size(); }
+    std::size_t size() const { return ids_.size(); }
+
+    // Bytes held by the arrays (capacity, not size)
+    std::size_t memoryUsage() const;
+
+private:
+    static constexpr std::uint32_t LeafSize = 4;
+
+    // count > 0: leaf over boxes [first, first + count); else an inner node
+    // whose children are nodes first and first + 1
+    struct Node {
+        GameObject::AABB box;
+        std::uint32_t first;
+        std::uint32_t count;
+    };
+
+    std::vector<Node> nodes_;              // nodes_[0] is the root
+    std::vector<GameObject::AABB> boxes_;  // in leaf order
+    std::vector<std::uint32_t> ids_;       // collider index per box
+    std::vector<float> centers_;           // build scratch: x, z per box
+
+    void split(std::uint32_t node);
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_COLLIDERBVH_HPP
@@ -0,0 +1,53 @@
+#include "ColliderStore.hpp"
+#include <algorithm>
+
+std::uint32_t ColliderStore::add(const GameObject::AABB& box, ColliderKind kind) {
+    const auto index = static_cast<std::uint32_t>(kind_.size());
+
+    minX_.push_back(box.minX);
+    maxX_.push_back(box.maxX);
+    minZ_.push_back(box.minZ);
+    maxZ_.push_back(box.maxZ);
+    kind_.push_back(kind);
+
+    if ((index >> 6) >= active_.size()) active_.push_back(0);
+    setActive(index, true);
+
+    return index;
+}
+
+void ColliderStore::reserve(std::size_t count) {
+    minX_.reserve(count);
+    maxX_.reserve(count);
+    minZ_.reserve(count);
+    maxZ_.reserve(count);
+    kind_.reserve(count);
+    active_.reserve((count + 63) / 64);
+}
+
+void ColliderStore::clear() {
+    minX_.clear();
+    maxX_.clear();
+    minZ_.clear();
+    maxZ_.clear();
+    kind_.clear();
+    active_.clear();
+}
+
+bool ColliderStore::setActiveBits(const std::vector<std::uint64_t>& bits) {
+    if (bits.size() != active_.size()) return false;
+    std::copy(bits.begin(), bits.end(), active_.begin());
+    return true;
+}
+
+std::size_t ColliderStore::memoryUsage() const {
+    return (minX_.capacity() + maxX_.capacity() + minZ_.capacity() + maxZ_.capacity()) * sizeof(float) +
+           kind_.capacity() * sizeof(ColliderKind) +
+           active_.capacity() * sizeof(std::uint64_t);
+}
+
+void ColliderStore::bind(std::uint32_t i, GameObject& obj) {
+    setActive(i, obj.active_);
+    obj.activeWord_ = &active_[i >> 6];
+    obj.activeMask_ = std::uint64_t{1} << (i & 63);
+}
@@ -0,0 +1,72 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_COLLIDERSTORE_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_COLLIDERSTORE_HPP
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "GameObject.hpp"
+
+// What the narrowphase does when the car overlaps a collider
+enum class ColliderKind : std::uint8_t {
+    Obstacle,
+    SpeedBoost,
+    SizeChange
+};
+
+// Structure-of-arrays storage for every collider in World.
+// The per-tick collision loop only touches these packed arrays, so it never
+// follows a GameObject pointer or makes a virtual call.
+class ColliderStore {
+public:
+    std::uint32_t add(const GameObject::AABB& box, ColliderKind kind);
+    void reserve(std::size_t count);
+    void clear();
+
+    std::size_t size() const { return kind_.size(); }
+    bool empty() const { return kind_.empty(); }
+
+    const float* minX() const { return minX_.data(); }
+    const float* maxX() const { return maxX_.data(); }
+    const float* minZ() const { return minZ_.data(); }
+    const float* maxZ() const { return maxZ_.data(); }
+
+    GameObject::AABB bounds(std::uint32_t i) const {
+        return {minX_[i], maxX_[i], minZ_[i], maxZ_[i]};
+    }
+
+    ColliderKind kind(std::uint32_t i) const { return kind_[i]; }
+
+    bool isActive(std::uint32_t i) const {
+        return (active_[i >> 6] >> (i & 63)) & 1u;
+    }
+
+    void setActive(std::uint32_t i, bool active) {
+        const std::uint64_t bit = std::uint64_t{1} << (i & 63);
+        if (active) active_[i >> 6] |= bit;
+        else        active_[i >> 6] &= ~bit;
+    }
+
+    const std::vector<std::uint64_t>& activeBits() const { return active_; }
+
+    // Overwrites every active flag at once (bits from activeBits() of a
+    // store with the same size). Bound objects keep pointing at the same words.
+    bool setActiveBits(const std::vector<std::uint64_t>& bits);
+
+    // Bytes held by the arrays (capacity, not size)
+    std::size_t memoryUsage() const;
+
+    // Makes obj read and write its active flag through bit i of this store.
+    // Call after the last add(): adding may reallocate the bitset.
+    void bind(std::uint32_t i, GameObject& obj);
+
+private:
+    std::vector<float> minX_;
+    std::vector<float> maxX_;
+    std::vector<float> minZ_;
+    std::vector<float> maxZ_;
+    std::vector<ColliderKind> kind_;
+    std::vector<std::uint64_t> active_;
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_COLLIDERSTORE_HPP
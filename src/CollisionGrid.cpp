@@ -0,0 +1,199 @@
+#include "CollisionGrid.hpp"
+#include "AabbKernel.hpp"
+#include "ObbKernel.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+CollisionGrid::CollisionGrid(float cellSize)
+    : baseCellSize_(cellSize), cellSize_(cellSize) {}
+
+void CollisionGrid::clear() {
+    cols_ = rows_ = 0;
+    cellStart_.clear();
+    cellIds_.clear();
+    cellMinX_.clear();
+    cellMaxX_.clear();
+    cellMinZ_.clear();
+    cellMaxZ_.clear();
+}
+
+std::size_t CollisionGrid::memoryUsage() const {
+    return (cellStart_.capacity() + cellIds_.capacity()) * sizeof(std::uint32_t) +
+           (cellMinX_.capacity() + cellMaxX_.capacity() + cellMinZ_.capacity() + cellMaxZ_.capacity()) * sizeof(float);
+}
+
+int CollisionGrid::cellX(float x) const {
+    int c = static_cast<int>(std::floor((x - originX_) / cellSize_));
+    return std::clamp(c, 0, cols_ - 1);
+}
+
+int CollisionGrid::cellZ(float z) const {
+    int r = static_cast<int>(std::floor((z - originZ_) / cellSize_));
+    return std::clamp(r, 0, rows_ - 1);
+}
+
+void CollisionGrid::build(const ColliderStore& colliders) {
+    clear();
+    const std::size_t count = colliders.size();
+    if (count == 0) return;
+
+    // Grid covers the union of all boxes
+    float minX = colliders.minX()[0], maxX = colliders.maxX()[0];
+    float minZ = colliders.minZ()[0], maxZ = colliders.maxZ()[0];
+    for (std::uint32_t i = 0; i < count; ++i) {
+        minX = std::min(minX, colliders.minX()[i]);
+        maxX = std::max(maxX, colliders.maxX()[i]);
+        minZ = std::min(minZ, colliders.minZ()[i]);
+        maxZ = std::max(maxZ, colliders.maxZ()[i]);
+    }
+
+    originX_ = minX;
+    originZ_ = minZ;
+
+    // Keep the cell count proportional to the collider count, so a sparse
+    // but very large world does not allocate millions of empty cells.
+    const double maxCells = std::max<double>(64.0, 4.0 * static_cast<double>(count));
+    const double area = std::max(1.0, double(maxX - minX) * double(maxZ - minZ));
+    cellSize_ = std::max(baseCellSize_, static_cast<float>(std::sqrt(area / maxCells)));
+
+    cols_ = static_cast<int>(std::floor((maxX - minX) / cellSize_)) + 1;
+    rows_ = static_cast<int>(std::floor((maxZ - minZ) / cellSize_)) + 1;
+
+    const std::size_t cellCount = static_cast<std::size_t>(cols_) * rows_;
+    cellStart_.assign(cellCount + 1, 0);
+
+    // pass 1: count entries per cell
+    for (std::uint32_t id = 0; id < count; ++id) {
+        const auto b = colliders.bounds(id);
+        int x0 = cellX(b.minX), x1 = cellX(b.maxX);
+        int z0 = cellZ(b.minZ), z1 = cellZ(b.maxZ);
+        for (int r = z0; r <= z1; ++r)
+            for (int c = x0; c <= x1; ++c)
+                cellStart_[r * cols_ + c + 1]++;
+    }
+
+    for (std::size_t i = 1; i <= cellCount; ++i) {
+        cellStart_[i] += cellStart_[i - 1];
+    }
+
+    // pass 2: fill back to front, using cellStart_[c + 1] (the end of cell
+    // c) as its cursor, so ids end up ascending inside every cell and a
+    // rebuild of the same size does not allocate
+    const std::size_t entries = cellStart_[cellCount];
+    cellIds_.resize(entries);
+    cellMinX_.resize(entries);
+    cellMaxX_.resize(entries);
+    cellMinZ_.resize(entries);
+    cellMaxZ_.resize(entries);
+
+    for (std::uint32_t id = count; id-- > 0;) {
+        const auto b = colliders.bounds(id);
+        int x0 = cellX(b.minX), x1 = cellX(b.maxX);
+        int z0 = cellZ(b.minZ), z1 = cellZ(b.maxZ);
+        for (int r = z0; r <= z1; ++r) {
+            for (int c = x0; c <= x1; ++c) {
+                const std::uint32_t e = --cellStart_[r * cols_ + c + 1];
+                cellIds_[e] = id;
+                cellMinX_[e] = b.minX;
+                cellMaxX_[e] = b.maxX;
+                cellMinZ_[e] = b.minZ;
+                cellMaxZ_[e] = b.maxZ;
+            }
+        }
+    }
+
+    // the cursors now hold the starts, one slot too far right
+    std::copy(cellStart_.begin() + 1, cellStart_.end(), cellStart_.begin());
+    cellStart_[cellCount] = static_cast<std::uint32_t>(entries);
+}
+
+void CollisionGrid::query(const Car::AABB& box, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    if (cols_ == 0) return;
+
+    // Entirely outside the grid -> nothing can overlap
+    const float maxX = originX_ + cols_ * cellSize_;
+    const float maxZ = originZ_ + rows_ * cellSize_;
+    if (box.maxX < originX_ || box.minX > maxX ||
+        box.maxZ < originZ_ || box.minZ > maxZ) {
+        return;
+    }
+
+    int x0 = cellX(box.minX), x1 = cellX(box.maxX);
+    int z0 = cellZ(box.minZ), z1 = cellZ(box.maxZ);
+
+    for (int r = z0; r <= z1; ++r) {
+        for (int c = x0; c <= x1; ++c) {
+            const std::size_t cell = static_cast<std::size_t>(r) * cols_ + c;
+            out.insert(out.end(),
+                       cellIds_.begin() + cellStart_[cell],
+                       cellIds_.begin() + cellStart_[cell + 1]);
+        }
+    }
+
+    // A box spanning several cells shows up once per cell
+    if (x0 != x1 || z0 != z1) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+}
+
+void CollisionGrid::queryOverlaps(const Car::AABB& box, std::vector<std::uint32_t>& out) const {
+    queryMasked(box, nullptr, out);
+}
+
+void CollisionGrid::queryOverlaps(const Car::OBB& car, std::vector<std::uint32_t>& out) const {
+    queryMasked(car.enclosing(), &car, out);
+}
+
+void CollisionGrid::queryMasked(const Car::AABB& box, const Car::OBB* car, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    if (cols_ == 0) return;
+
+    const float maxX = originX_ + cols_ * cellSize_;
+    const float maxZ = originZ_ + rows_ * cellSize_;
+    if (box.maxX < originX_ || box.minX > maxX ||
+        box.maxZ < originZ_ || box.minZ > maxZ) {
+        return;
+    }
+
+    int x0 = cellX(box.minX), x1 = cellX(box.maxX);
+    int z0 = cellZ(box.minZ), z1 = cellZ(box.maxZ);
+
+    for (int r = z0; r <= z1; ++r) {
+        for (int c = x0; c <= x1; ++c) {
+            const std::size_t cell = static_cast<std::size_t>(r) * cols_ + c;
+            const std::size_t first = cellStart_[cell];
+            const std::size_t last = cellStart_[cell + 1];
+
+            // one mask word per 64 entries keeps the scratch on the stack
+            for (std::size_t base = first; base < last; base += 64) {
+                const std::size_t n = std::min<std::size_t>(64, last - base);
+
+                std::uint64_t mask = 0;
+                if (car) {
+                    obbOverlapMask(*car,
+                                   cellMinX_.data() + base, cellMaxX_.data() + base,
+                                   cellMinZ_.data() + base, cellMaxZ_.data() + base,
+                                   n, &mask);
+                } else {
+                    aabbOverlapMask(box,
+                                    cellMinX_.data() + base, cellMaxX_.data() + base,
+                                    cellMinZ_.data() + base, cellMaxZ_.data() + base,
+                                    n, &mask);
+                }
+
+                while (mask) {
+                    out.push_back(cellIds_[base + std::countr_zero(mask)]);
+                    mask &= mask - 1;
+                }
+            }
+        }
+    }
+
+    if (x0 != x1 || z0 != z1) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_COLLISIONGRID_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_COLLISIONGRID_HPP
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Car.hpp"
+#include "ColliderStore.hpp"
+
+// Uniform-grid broadphase over the static collider boxes in World.
+// Built once per reset; each query returns the indices of every box that
+// shares at least one cell with the query box (sorted, no duplicates).
+class CollisionGrid {
+public:
+    explicit CollisionGrid(float cellSize = 16.f);
+
+    void build(const ColliderStore& colliders);
+    void clear();
+
+    // Candidate indices are written to 'out' in ascending order.
+    void query(const Car::AABB& box, std::vector<std::uint32_t>& out) const;
+
+    // Like query(), but only keeps colliders whose box actually overlaps
+    // 'box' (tested per cell with the SIMD kernel in AabbKernel.hpp).
+    void queryOverlaps(const Car::AABB& box, std::vector<std::uint32_t>& out) const;
+
+    // Same for the rotated car: cells under car.enclosing(), then the
+    // batched SAT test from ObbKernel.hpp per cell
+    void queryOverlaps(const Car::OBB& car, std::vector<std::uint32_t>& out) const;
+
+    // Bytes held by the cell arrays (capacity, not size)
+    std::size_t memoryUsage() const;
+
+    float cellSize() const { return cellSize_; }
+    int columns() const { return cols_; }
+    int rows() const { return rows_; }
+
+private:
+    float baseCellSize_;
+    float cellSize_;
+    float originX_ = 0.f;
+    float originZ_ = 0.f;
+    int cols_ = 0;
+    int rows_ = 0;
+
+    // CSR layout: entries of cell c are cellIds_[cellStart_[c] .. cellStart_[c + 1])
+    std::vector<std::uint32_t> cellStart_;
+    std::vector<std::uint32_t> cellIds_;
+
+    // copies of the boxes in cellIds_ order, so every cell is one packed run
+    std::vector<float> cellMinX_;
+    std::vector<float> cellMaxX_;
+    std::vector<float> cellMinZ_;
+    std::vector<float> cellMaxZ_;
+
+    int cellX(float x) const;
+    int cellZ(float z) const;
+    void queryMasked(const Car::AABB& box, const Car::OBB* car, std::vector<std::uint32_t>& out) const;
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_COLLISIONGRID_HPP
@@ -0,0 +1,110 @@
+#include "FastMath.hpp"
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BILSIM_FASTMATH_SSE2 1
+#endif
+
+namespace {
+
+constexpr float FourOverPi = 1.27323954473516f;
+
+// pi/4 split in three parts for an exact-ish range reduction
+constexpr float DP1 = 0.78515625f;
+constexpr float DP2 = 2.4187564849853515625e-4f;
+constexpr float DP3 = 3.77489497744594108e-8f;
+
+constexpr float Cos0 = 2.443315711809948e-5f;
+constexpr float Cos1 = -1.388731625493765e-3f;
+constexpr float Cos2 = 4.166664568298827e-2f;
+
+constexpr float Sin0 = -1.9515295891e-4f;
+constexpr float Sin1 = 8.3321608736e-3f;
+constexpr float Sin2 = -1.6666654611e-1f;
+
+}
+
+void sinCosScalar(float angle, float& sinOut, float& cosOut) {
+    const bool negative = angle < 0.f;
+    float x = std::fabs(angle);
+
+    // octant, rounded up to even
+    int j = static_cast<int>(x * FourOverPi);
+    j = (j + 1) & ~1;
+    const float y = static_cast<float>(j);
+
+    const bool flipSin = ((j & 4) != 0) != negative;
+    const bool flipCos = ((j - 2) & 4) == 0;
+    const bool swap = (j & 2) != 0;
+
+    x = ((x - y * DP1) - y * DP2) - y * DP3;
+    const float z = x * x;
+
+    float c = ((Cos0 * z + Cos1) * z + Cos2) * z * z - 0.5f * z + 1.f;
+    float s = ((Sin0 * z + Sin1) * z + Sin2) * z * x + x;
+
+    float sn = swap ? c : s;
+    float cs = swap ? s : c;
+
+    sinOut = flipSin ? -sn : sn;
+    cosOut = flipCos ? -cs : cs;
+}
+
+void sinCosBatch(const float* angles, float* sinOut, float* cosOut, std::size_t count) {
+    std::size_t i = 0;
+
+#if defined(BILSIM_FASTMATH_SSE2)
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i notOne = _mm_set1_epi32(~1);
+    const __m128i two = _mm_set1_epi32(2);
+    const __m128i four = _mm_set1_epi32(4);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(angles + i);
+
+        __m128 signSin = _mm_and_ps(x, signMask);
+        x = _mm_andnot_ps(signMask, x);
+
+        __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(FourOverPi)));
+        j = _mm_and_si128(_mm_add_epi32(j, one), notOne);
+        __m128 y = _mm_cvtepi32_ps(j);
+
+        // (j & 4) -> flip sin, ((j - 2) & 4) == 0 -> flip cos, (j & 2) -> swap
+        __m128 flipSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, four), 29));
+        __m128 flipCos = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, two), four), 29));
+        __m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, two), zero));
+
+        signSin = _mm_xor_ps(signSin, flipSin);
+
+        x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(DP1)));
+        x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(DP2)));
+        x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(DP3)));
+        __m128 z = _mm_mul_ps(x, x);
+
+        __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(Cos0), z), _mm_set1_ps(Cos1));
+        c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(Cos2));
+        c = _mm_mul_ps(_mm_mul_ps(c, z), z);
+        c = _mm_sub_ps(c, _mm_mul_ps(_mm_set1_ps(0.5f), z));
+        c = _mm_add_ps(c, _mm_set1_ps(1.f));
+
+        __m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(Sin0), z), _mm_set1_ps(Sin1));
+        s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(Sin2));
+        s = _mm_mul_ps(_mm_mul_ps(s, z), x);
+        s = _mm_add_ps(s, x);
+
+        __m128 sn = _mm_or_ps(_mm_and_ps(polyMask, s), _mm_andnot_ps(polyMask, c));
+        __m128 cs = _mm_or_ps(_mm_and_ps(polyMask, c), _mm_andnot_ps(polyMask, s));
+
+        _mm_storeu_ps(sinOut + i, _mm_xor_ps(sn, signSin));
+        _mm_storeu_ps(cosOut + i, _mm_xor_ps(cs, flipCos));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        sinCosScalar(angles[i], sinOut[i], cosOut[i]);
+    }
+}
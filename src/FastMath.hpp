@@ -0,0 +1,14 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_FASTMATH_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_FASTMATH_HPP
+#pragma once
+
+#include <cstddef>
+
+// Batched sin/cos (Cephes-style range reduction + minimax polynomials).
+// Four lanes per step with SSE2, scalar elsewhere; every path uses the same
+// arithmetic. Absolute error is around 1e-7 for |angle| < 8192.
+void sinCosBatch(const float* angles, float* sinOut, float* cosOut, std::size_t count);
+
+void sinCosScalar(float angle, float& sinOut, float& cosOut);
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_FASTMATH_HPP
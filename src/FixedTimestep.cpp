@@ -0,0 +1,27 @@
+#include "FixedTimestep.hpp"
+#include <algorithm>
+
+FixedTimestep::FixedTimestep(double stepSeconds, int maxSubsteps)
+    : step_(stepSeconds > 0.0 ? stepSeconds : 1.0 / 60.0),
+      maxSubsteps_(std::max(1, maxSubsteps)) {}
+
+int FixedTimestep::advance(double frameSeconds) {
+    accumulator_ += std::max(0.0, frameSeconds);
+
+    // tiny slack so 144 frames of 1/144 s really give 60 steps of 1/60 s
+    int steps = static_cast<int>((accumulator_ + step_ * 1e-6) / step_);
+    if (steps > maxSubsteps_) {
+        // spiral of death guard: keep the fraction, drop whole steps
+        dropped_ += (steps - maxSubsteps_) * step_;
+        accumulator_ -= (steps - maxSubsteps_) * step_;
+        steps = maxSubsteps_;
+    }
+
+    accumulator_ = std::max(0.0, accumulator_ - steps * step_);
+    return steps;
+}
+
+void FixedTimestep::reset() {
+    accumulator_ = 0.0;
+    dropped_ = 0.0;
+}
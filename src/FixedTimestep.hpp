@@ -0,0 +1,30 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_FIXEDTIMESTEP_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_FIXEDTIMESTEP_HPP
+#pragma once
+
+// Fixed-step accumulator for the main loop.
+// Feed it the real frame time; it says how many simulation steps to run and
+// how far (0..1) the renderer is between the last two simulated states.
+// At most maxSubsteps are run per frame, the rest of a long hitch is dropped
+// so a slow frame cannot snowball into ever more simulation work.
+class FixedTimestep {
+public:
+    explicit FixedTimestep(double stepSeconds = 1.0 / 60.0, int maxSubsteps = 8);
+
+    int advance(double frameSeconds);
+    void reset();
+
+    float step() const { return static_cast<float>(step_); }
+    float alpha() const { return static_cast<float>(accumulator_ / step_); }
+
+    // total simulation time thrown away by the substep cap
+    double droppedSeconds() const { return dropped_; }
+
+private:
+    double step_;
+    int maxSubsteps_;
+    double accumulator_ = 0.0;
+    double dropped_ = 0.0;
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_FIXEDTIMESTEP_HPP
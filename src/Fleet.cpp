@@ -0,0 +1,317 @@
+#include "Fleet.hpp"
+#include "FastMath.hpp"
+#include "Obstacle.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace {
+
+// xorshift32, one state per car so the fleet is deterministic per seed
+float nextFloat(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<float>(state >> 8) * (1.f / 16777216.f);
+}
+
+// strict, so cars that were just pushed apart (touching) stay out of contact
+bool overlaps(const Car::AABB& a, const Car::AABB& b) {
+    return a.minX < b.maxX && a.maxX > b.minX &&
+           a.minZ < b.maxZ && a.maxZ > b.minZ;
+}
+
+}
+
+void Fleet::clear() {
+    posX_.clear();
+    posZ_.clear();
+    rot_.clear();
+    speed_.clear();
+    sin_.clear();
+    cos_.clear();
+    input_.clear();
+    targetX_.clear();
+    targetZ_.clear();
+    rng_.clear();
+    contacts_ = 0;
+}
+
+void Fleet::spawn(std::size_t count, std::uint32_t seed, const Area& area,
+                  const ColliderStore& colliders, const CollisionGrid& grid) {
+    clear();
+    area_ = area;
+
+    posX_.resize(count);
+    posZ_.resize(count);
+    rot_.resize(count);
+    speed_.assign(count, 0.f);
+    sin_.resize(count);
+    cos_.resize(count);
+    input_.assign(count, 0);
+    targetX_.resize(count);
+    targetZ_.resize(count);
+    rng_.resize(count);
+
+    std::uint32_t spawnRng = seed ? seed : 1u;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        rng_[i] = static_cast<std::uint32_t>(i) * 2654435761u ^ seed;
+        if (rng_[i] == 0) rng_[i] = 1;
+
+        // try a few spots that are not inside a collider
+        for (int attempt = 0; attempt < 32; ++attempt) {
+            posX_[i] = area.minX + nextFloat(spawnRng) * (area.maxX - area.minX);
+            posZ_[i] = area.minZ + nextFloat(spawnRng) * (area.maxZ - area.minZ);
+
+            grid.queryOverlaps(bounds(i), hits_);
+            bool blocked = std::any_of(hits_.begin(), hits_.end(),
+                                       [&](std::uint32_t c) { return colliders.isActive(c); });
+            if (!blocked) break;
+        }
+
+        rot_[i] = (nextFloat(spawnRng) * 2.f - 1.f) * std::numbers::pi_v<float>;
+        pickTarget(i);
+    }
+
+    sinCosBatch(rot_.data(), sin_.data(), cos_.data(), count);
+}
+
+void Fleet::saveState(State& out) const {
+    out.posX = posX_;
+    out.posZ = posZ_;
+    out.rot = rot_;
+    out.speed = speed_;
+    out.targetX = targetX_;
+    out.targetZ = targetZ_;
+    out.rng = rng_;
+}
+
+bool Fleet::restoreState(const State& state) {
+    if (state.posX.size() != size()) return false;
+
+    posX_ = state.posX;
+    posZ_ = state.posZ;
+    rot_ = state.rot;
+    speed_ = state.speed;
+    targetX_ = state.targetX;
+    targetZ_ = state.targetZ;
+    rng_ = state.rng;
+
+    // same function as integrate(), so the restored heading is bit-identical
+    sinCosBatch(rot_.data(), sin_.data(), cos_.data(), size());
+    contacts_ = 0;
+    return true;
+}
+
+void Fleet::pickTarget(std::size_t i) {
+    targetX_[i] = area_.minX + nextFloat(rng_[i]) * (area_.maxX - area_.minX);
+    targetZ_[i] = area_.minZ + nextFloat(rng_[i]) * (area_.maxZ - area_.minZ);
+}
+
+void Fleet::update(float dt, const ColliderStore& colliders, const CollisionGrid& grid, Car& player) {
+    if (empty()) return;
+    BILSIM_PROFILE_SCOPE("Fleet::update");
+
+    drive();
+    integrate(dt);
+    collideStatic(colliders, grid);
+    collideCars(player);
+}
+
+void Fleet::drive() {
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i) {
+        float dx = targetX_[i] - posX_[i];
+        float dz = targetZ_[i] - posZ_[i];
+        float dist2 = dx * dx + dz * dz;
+
+        if (dist2 < 25.f) {
+            pickTarget(i);
+            dx = targetX_[i] - posX_[i];
+            dz = targetZ_[i] - posZ_[i];
+            dist2 = dx * dx + dz * dz;
+        }
+
+        // heading is (sin, cos); cross > 0 means the target is to the left
+        float cross = cos_[i] * dx - sin_[i] * dz;
+        float dot = sin_[i] * dx + cos_[i] * dz;
+
+        std::uint8_t in = Accelerate;
+        if (dot < 0.f || cross * cross > 0.0025f * dist2) {
+            in |= (cross >= 0.f) ? TurnLeft : TurnRight;
+        }
+        input_[i] = in;
+    }
+}
+
+void Fleet::integrate(float dt) {
+    const std::size_t n = size();
+    const float pi = std::numbers::pi_v<float>;
+    const float twoPi = 2.f * pi;
+
+    // speed + heading, branch free so the compiler can vectorize it
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint8_t in = input_[i];
+        const bool accel = (in & Accelerate) != 0;
+        const bool brake = (in & Brake) != 0;
+
+        float s = speed_[i];
+        s += accel ? acceleration_ * dt : 0.f;
+        s -= brake ? brakeDeceleration_ * dt : 0.f;
+
+        const float f = friction_ * dt;
+        const float coasted = s > 0.f ? std::max(0.f, s - f) : std::min(0.f, s + f);
+        s = (accel || brake) ? s : coasted;
+
+        s = std::clamp(s, -maxSpeed_ * 0.5f, maxSpeed_);
+        speed_[i] = s;
+
+        const float turn = float((in & TurnLeft) != 0) - float((in & TurnRight) != 0);
+        float r = rot_[i] + (std::abs(s) > 0.1f ? turn * turnSpeed_ * dt : 0.f);
+
+        // keep angles small for the sin/cos range reduction
+        r = r > pi ? r - twoPi : r;
+        r = r < -pi ? r + twoPi : r;
+        rot_[i] = r;
+    }
+
+    sinCosBatch(rot_.data(), sin_.data(), cos_.data(), n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const float step = speed_[i] * dt;
+        posX_[i] += sin_[i] * step;
+        posZ_[i] += cos_[i] * step;
+    }
+}
+
+void Fleet::collideStatic(const ColliderStore& colliders, const CollisionGrid& grid) {
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i) {
+        grid.queryOverlaps(bounds(i), hits_);
+
+        for (auto c : hits_) {
+            // AI cars do not collect pickups
+            if (!colliders.isActive(c) || colliders.kind(c) != ColliderKind::Obstacle) continue;
+
+            Obstacle::resolve(colliders.bounds(c), posX_[i], posZ_[i], halfW_, halfL_);
+            speed_[i] = 0.f;
+            pickTarget(i); // try somewhere else instead of pushing into the wall
+        }
+    }
+}
+
+void Fleet::collideCars(Car& player) {
+    const auto n = static_cast<std::uint32_t>(size());
+    const std::uint32_t entries = n + 1; // fleet + player (last entry)
+
+    float playerX = player.position().x;
+    float playerZ = player.position().z;
+    bool playerHit = false;
+
+    auto x = [&](std::uint32_t k) -> float& { return k == n ? playerX : posX_[k]; };
+    auto z = [&](std::uint32_t k) -> float& { return k == n ? playerZ : posZ_[k]; };
+    auto hw = [&](std::uint32_t k) { return k == n ? player.getHalfWidth() : halfW_; };
+    auto hl = [&](std::uint32_t k) { return k == n ? player.getHalfLength() : halfL_; };
+    auto box = [&](std::uint32_t k) -> Car::AABB {
+        return {x(k) - hw(k), x(k) + hw(k), z(k) - hl(k), z(k) + hl(k)};
+    };
+
+    // Uniform grid on car centres. With cells at least as wide as two of the
+    // largest half extents, overlapping cars are always in neighbouring cells.
+    float minX = playerX, maxX = playerX, minZ = playerZ, maxZ = playerZ;
+    for (std::uint32_t k = 0; k < n; ++k) {
+        minX = std::min(minX, posX_[k]);
+        maxX = std::max(maxX, posX_[k]);
+        minZ = std::min(minZ, posZ_[k]);
+        maxZ = std::max(maxZ, posZ_[k]);
+    }
+
+    float cell = 2.f * std::max({halfW_, halfL_, player.getHalfWidth(), player.getHalfLength()});
+    const double area = std::max(1.0, double(maxX - minX) * double(maxZ - minZ));
+    const double maxCells = std::max(64.0, 4.0 * entries);
+    cell = std::max(cell, static_cast<float>(std::sqrt(area / maxCells)));
+
+    const int cols = static_cast<int>((maxX - minX) / cell) + 1;
+    const int rows = static_cast<int>((maxZ - minZ) / cell) + 1;
+    const std::size_t cellCount = static_cast<std::size_t>(cols) * rows;
+
+    auto cellOf = [&](float px, float pz) {
+        int c = std::clamp(static_cast<int>((px - minX) / cell), 0, cols - 1);
+        int r = std::clamp(static_cast<int>((pz - minZ) / cell), 0, rows - 1);
+        return static_cast<std::uint32_t>(r * cols + c);
+    };
+
+    // counting sort of the cars into cells
+    cellStart_.assign(cellCount + 1, 0);
+    carCell_.resize(entries);
+    cellCars_.resize(entries);
+
+    for (std::uint32_t k = 0; k < entries; ++k) {
+        carCell_[k] = cellOf(x(k), z(k));
+        cellStart_[carCell_[k] + 1]++;
+    }
+    for (std::size_t c = 1; c <= cellCount; ++c) cellStart_[c] += cellStart_[c - 1];
+
+    cellFill_.assign(cellStart_.begin(), cellStart_.end() - 1);
+    for (std::uint32_t k = 0; k < entries; ++k) {
+        cellCars_[cellFill_[carCell_[k]]++] = k;
+    }
+
+    contacts_ = 0;
+
+    // Pushing one pair apart can push a car into a third one, so relax a
+    // few times (usually the second pass already finds nothing).
+    for (int pass = 0; pass < 4; ++pass) {
+        std::size_t resolved = 0;
+
+        for (std::uint32_t a = 0; a < entries; ++a) {
+            const int ac = static_cast<int>(carCell_[a] % cols);
+            const int ar = static_cast<int>(carCell_[a] / cols);
+
+            for (int r = std::max(0, ar - 1); r <= std::min(rows - 1, ar + 1); ++r) {
+                for (int c = std::max(0, ac - 1); c <= std::min(cols - 1, ac + 1); ++c) {
+                    const std::size_t cellIndex = static_cast<std::size_t>(r) * cols + c;
+
+                    for (std::uint32_t e = cellStart_[cellIndex]; e < cellStart_[cellIndex + 1]; ++e) {
+                        const std::uint32_t b = cellCars_[e];
+                        if (b <= a) continue; // each pair once
+
+                        const auto ba = box(a);
+                        const auto bb = box(b);
+                        if (!overlaps(ba, bb)) continue;
+
+                        // push both cars half way out along the axis of least overlap
+                        float overlapX = std::min(ba.maxX - bb.minX, bb.maxX - ba.minX);
+                        float overlapZ = std::min(ba.maxZ - bb.minZ, bb.maxZ - ba.minZ);
+
+                        if (overlapX < overlapZ) {
+                            float push = 0.5f * overlapX * (x(a) < x(b) ? -1.f : 1.f);
+                            x(a) += push;
+                            x(b) -= push;
+                        } else {
+                            float push = 0.5f * overlapZ * (z(a) < z(b) ? -1.f : 1.f);
+                            z(a) += push;
+                            z(b) -= push;
+                        }
+
+                        for (auto k : {a, b}) {
+                            if (k == n) playerHit = true;
+                            else speed_[k] = 0.f;
+                        }
+                        resolved++;
+                    }
+                }
+            }
+        }
+
+        if (pass == 0) contacts_ = resolved;
+        if (resolved == 0) break;
+    }
+
+    if (playerHit) {
+        player.setPosition(playerX, playerZ);
+        player.setSpeed(0.f);
+    }
+}
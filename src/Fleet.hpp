@@ -0,0 +1,110 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_FLEET_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_FLEET_HPP
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Car.hpp"
+#include "ColliderStore.hpp"
+#include "CollisionGrid.hpp"
+
+// AI traffic for World: any number of simple cars stored as structure-of-
+// arrays and stepped together. Same driving model as Car (without the
+// pickup effects); each AI car steers towards a random waypoint.
+//
+// Per tick: drive (pick inputs) -> integrate (batched, vectorized sin/cos)
+// -> static colliders via the world's grid -> car-vs-car (incl. the player).
+class Fleet {
+public:
+    // Region the AI cars spawn in and pick waypoints from
+    struct Area {
+        float minX, maxX;
+        float minZ, maxZ;
+    };
+
+    void spawn(std::size_t count, std::uint32_t seed, const Area& area,
+               const ColliderStore& colliders, const CollisionGrid& grid);
+    void clear();
+
+    void update(float dt, const ColliderStore& colliders, const CollisionGrid& grid, Car& player);
+
+    std::size_t size() const { return posX_.size(); }
+    bool empty() const { return posX_.empty(); }
+
+    Vec2 position(std::size_t i) const { return {posX_[i], posZ_[i]}; }
+    float rotation(std::size_t i) const { return rot_[i]; }
+    float speed(std::size_t i) const { return speed_[i]; }
+    Car::AABB bounds(std::size_t i) const {
+        return {posX_[i] - halfW_, posX_[i] + halfW_, posZ_[i] - halfL_, posZ_[i] + halfL_};
+    }
+
+    float halfWidth() const { return halfW_; }
+    float halfLength() const { return halfL_; }
+
+    // car-vs-car contacts resolved during the last update
+    std::size_t contacts() const { return contacts_; }
+
+    // Per-car state carried from one tick to the next (heading sin/cos and
+    // inputs are derived from it). Copying into a State of the same size
+    // reuses its buffers.
+    struct State {
+        std::vector<float> posX, posZ;
+        std::vector<float> rot, speed;
+        std::vector<float> targetX, targetZ;
+        std::vector<std::uint32_t> rng;
+    };
+
+    void saveState(State& out) const;
+    // false (and nothing changed) if the state is for a different car count
+    bool restoreState(const State& state);
+
+private:
+    enum : std::uint8_t {
+        Accelerate = 1,
+        Brake = 2,
+        TurnLeft = 4,
+        TurnRight = 8
+    };
+
+    // same handling as Car, a bit slower top speed
+    float maxSpeed_ = 20.f;
+    float acceleration_ = 15.f;
+    float brakeDeceleration_ = 25.f;
+    float friction_ = 5.f;
+    float turnSpeed_ = 2.5f;
+    float halfW_ = 1.f;
+    float halfL_ = 2.f;
+
+    Area area_{};
+
+    // vehicle state
+    std::vector<float> posX_;
+    std::vector<float> posZ_;
+    std::vector<float> rot_;
+    std::vector<float> speed_;
+    std::vector<float> sin_;   // heading, refreshed by integrate()
+    std::vector<float> cos_;
+    std::vector<std::uint8_t> input_;
+
+    // AI state
+    std::vector<float> targetX_;
+    std::vector<float> targetZ_;
+    std::vector<std::uint32_t> rng_;
+
+    // car-vs-car grid scratch (rebuilt every tick)
+    std::vector<std::uint32_t> cellStart_;
+    std::vector<std::uint32_t> cellFill_;
+    std::vector<std::uint32_t> cellCars_;
+    std::vector<std::uint32_t> carCell_;
+    std::vector<std::uint32_t> hits_;
+    std::size_t contacts_ = 0;
+
+    void pickTarget(std::size_t i);
+    void drive();
+    void integrate(float dt);
+    void collideStatic(const ColliderStore& colliders, const CollisionGrid& grid);
+    void collideCars(Car& player);
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_FLEET_HPP
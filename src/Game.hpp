@@ -7,6 +7,9 @@
 
 class Game {
 public:
+    Game() = default;
+    explicit Game(const LevelView& level) : world_(level) {}
+
     void update(float dt, const InputState& input) {
         world_.update(dt, input);
     }
@@ -2,6 +2,7 @@
 #ifndef BIL_SIMULATOR_JOHN_MITCHEL_GAMEOBJECT_HPP
 #define BIL_SIMULATOR_JOHN_MITCHEL_GAMEOBJECT_HPP
 #pragma once
+#include <cstdint>
 #include "Car.hpp"
 
 class GameObject {
@@ -14,10 +15,18 @@ public:
     };
 
     AABB bounds() const { return bounds_; }
-    bool isActive() const { return active_; }
+
+    // Objects owned by a World keep their active flag in the world's
+    // ColliderStore bitset; free-standing objects use active_.
+    bool isActive() const {
+        return activeWord_ ? (*activeWord_ & activeMask_) != 0 : active_;
+    }
 
     // Allow world/objects to deactivate things like doors/obstacles
-    void deactivate() { active_ = false; }
+    void deactivate() {
+        if (activeWord_) *activeWord_ &= ~activeMask_;
+        else active_ = false;
+    }
 
     virtual void update(float dt) {}
     virtual void onCarOverlap(Car& car) = 0;
@@ -25,6 +34,22 @@ public:
 protected:
     AABB bounds_{};
     bool active_ = true;
+
+private:
+    friend class ColliderStore;
+    std::uint64_t* activeWord_ = nullptr;
+    std::uint64_t activeMask_ = 0;
+};
+
+// Non-owning handle returned by World::objects().
+// Same get()/-> interface as the unique_ptr entries it replaced.
+struct ObjectRef {
+    GameObject* ptr = nullptr;
+
+    GameObject* get() const { return ptr; }
+    GameObject* operator->() const { return ptr; }
+    GameObject& operator*() const { return *ptr; }
+    explicit operator bool() const { return ptr != nullptr; }
 };
 
 
@@ -0,0 +1,246 @@
+#include "InputRecording.hpp"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace {
+
+constexpr char Magic[4] = {'B', 'R', 'E', 'C'};
+constexpr std::uint32_t Version = 2;  // 1 (no substepping fields) is still read
+
+struct RecordingHeader {
+    char magic[4];
+    std::uint32_t version;
+    float stepSeconds;
+    std::uint32_t trafficCount;
+    std::uint32_t trafficSeed;
+    std::uint32_t runCount;
+    std::uint64_t tickCount;
+    std::uint64_t levelHash;
+    std::uint64_t checksum;
+    // version 2
+    float maxStepDistance;
+    std::uint32_t maxSubsteps;
+};
+
+static_assert(sizeof(RecordingHeader) == 56, "RecordingHeader is part of the file format");
+
+constexpr std::size_t HeaderBytesV1 = 48;
+
+constexpr std::size_t RunBytes = 5;
+
+// sanity limits for a loaded header: far above any real run, but a
+// corrupt file cannot make replay() spawn or substep without bound
+constexpr std::uint32_t MaxTrafficCount = 1u << 16;
+constexpr std::uint32_t MaxSubsteps = 256;
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+}
+
+std::uint8_t InputRecording::pack(const InputState& input) {
+    return static_cast<std::uint8_t>((input.accelerate ? Accelerate : 0) |
+                                     (input.brake ? Brake : 0) |
+                                     (input.turnLeft ? TurnLeft : 0) |
+                                     (input.turnRight ? TurnRight : 0));
+}
+
+InputState InputRecording::unpack(std::uint8_t keys) {
+    InputState in;
+    in.accelerate = (keys & Accelerate) != 0;
+    in.brake = (keys & Brake) != 0;
+    in.turnLeft = (keys & TurnLeft) != 0;
+    in.turnRight = (keys & TurnRight) != 0;
+    return in;
+}
+
+// -----------------------------------------------------
+// Recording
+// -----------------------------------------------------
+
+void InputRecording::begin(float stepSeconds, std::uint64_t levelHash,
+                           std::uint32_t trafficCount, std::uint32_t trafficSeed,
+                           float maxStepDistance, int maxSubsteps) {
+    stepSeconds_ = stepSeconds;
+    maxStepDistance_ = maxStepDistance;
+    maxSubsteps_ = maxSubsteps;
+    levelHash_ = levelHash;
+    trafficCount_ = trafficCount;
+    trafficSeed_ = trafficSeed;
+    tickCount_ = 0;
+    checksum_ = 0;
+    runs_.clear();
+    pendingReset_ = false;
+}
+
+void InputRecording::record(const InputState& input) {
+    std::uint8_t keys = pack(input);
+    if (pendingReset_) keys |= Reset;
+    pendingReset_ = false;
+
+    if (!runs_.empty() && runs_.back().keys == keys && runs_.back().ticks < UINT32_MAX) {
+        runs_.back().ticks++;
+    } else {
+        runs_.push_back({1, keys});
+    }
+    tickCount_++;
+}
+
+void InputRecording::finish(const World& world) {
+    // reset after the last tick: a zero-length run that only resets
+    if (pendingReset_) {
+        runs_.push_back({0, Reset});
+        pendingReset_ = false;
+    }
+    checksum_ = stateChecksum(world);
+}
+
+bool InputRecording::save(const std::string& path, std::string* error) const {
+    RecordingHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.stepSeconds = stepSeconds_;
+    header.trafficCount = trafficCount_;
+    header.trafficSeed = trafficSeed_;
+    header.runCount = static_cast<std::uint32_t>(runs_.size());
+    header.tickCount = tickCount_;
+    header.levelHash = levelHash_;
+    header.checksum = checksum_;
+    header.maxStepDistance = maxStepDistance_;
+    header.maxSubsteps = static_cast<std::uint32_t>(maxSubsteps_);
+
+    std::vector<char> bytes(sizeof(RecordingHeader) + runs_.size() * RunBytes);
+    std::memcpy(bytes.data(), &header, sizeof(RecordingHeader));
+
+    char* out = bytes.data() + sizeof(RecordingHeader);
+    for (const auto& run : runs_) {
+        std::memcpy(out, &run.ticks, 4);
+        out[4] = static_cast<char>(run.keys);
+        out += RunBytes;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (!file) return fail(error, "cannot write " + path);
+    return true;
+}
+
+bool InputRecording::load(const std::string& path, std::string* error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return fail(error, "cannot open " + path);
+
+    // version 1 ends before the substepping fields: substepping was off
+    RecordingHeader header{};
+    header.maxSubsteps = 8;
+    if (!file.read(reinterpret_cast<char*>(&header), HeaderBytesV1) ||
+        std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        return fail(error, "not a recording");
+    }
+    if (header.version != 1 && header.version != Version) return fail(error, "unsupported recording version");
+    if (header.version >= 2 &&
+        !file.read(reinterpret_cast<char*>(&header) + HeaderBytesV1, sizeof(header) - HeaderBytesV1)) {
+        return fail(error, "recording truncated");
+    }
+
+    if (!(header.stepSeconds > 0.f) || !std::isfinite(header.stepSeconds)) {
+        return fail(error, "invalid step length in recording");
+    }
+    if (header.trafficCount > MaxTrafficCount) return fail(error, "traffic count out of range");
+    if (header.maxSubsteps < 1 || header.maxSubsteps > MaxSubsteps) return fail(error, "substep count out of range");
+
+    // the run count is only trusted once the file is known to hold the runs
+    const std::streamoff body = file.tellg();
+    file.seekg(0, std::ios::end);
+    const std::streamoff size = file.tellg();
+    file.seekg(body);
+    if (body < 0 || size < body ||
+        std::uint64_t(size - body) / RunBytes < header.runCount) {
+        return fail(error, "recording truncated");
+    }
+
+    std::vector<char> bytes(static_cast<std::size_t>(header.runCount) * RunBytes);
+    if (!file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()))) {
+        return fail(error, "recording truncated");
+    }
+
+    std::vector<Run> runs(header.runCount);
+    std::uint64_t ticks = 0;
+    const char* in = bytes.data();
+    for (auto& run : runs) {
+        std::memcpy(&run.ticks, in, 4);
+        run.keys = static_cast<std::uint8_t>(in[4]);
+        ticks += run.ticks;
+        in += RunBytes;
+    }
+    if (ticks != header.tickCount) return fail(error, "recording runs do not add up to its tick count");
+
+    runs_ = std::move(runs);
+
+    stepSeconds_ = header.stepSeconds;
+    trafficCount_ = header.trafficCount;
+    trafficSeed_ = header.trafficSeed;
+    maxStepDistance_ = header.maxStepDistance;
+    maxSubsteps_ = static_cast<int>(header.maxSubsteps);
+    tickCount_ = header.tickCount;
+    levelHash_ = header.levelHash;
+    checksum_ = header.checksum;
+    pendingReset_ = false;
+    return true;
+}
+
+// -----------------------------------------------------
+// Replay
+// -----------------------------------------------------
+
+bool InputRecording::replay(Game& game, std::uint64_t* checksumOut) const {
+    game.world().setSubstepping(maxStepDistance_, maxSubsteps_);
+    game.world().spawnTraffic(trafficCount_, trafficSeed_);
+    game.reset();
+
+    for (const auto& run : runs_) {
+        const InputState input = unpack(run.keys);
+        const bool reset = (run.keys & Reset) != 0;
+
+        if (run.ticks == 0 && reset) game.reset();
+
+        for (std::uint32_t t = 0; t < run.ticks; ++t) {
+            if (reset) game.reset();
+            game.update(stepSeconds_, input);
+        }
+    }
+
+    const std::uint64_t sum = stateChecksum(game.world());
+    if (checksumOut) *checksumOut = sum;
+    return sum == checksum_;
+}
+
+std::uint64_t stateChecksum(const World& world) {
+    std::uint64_t h = 14695981039346656037ull;
+    auto mix = [&](const void* data, std::size_t size) {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            h ^= p[i];
+            h *= 1099511628211ull;
+        }
+    };
+
+    const Car& car = world.car();
+    const float carState[] = {car.position().x, car.position().z, car.rotation(),
+                              car.speed(), car.getVisualScale()};
+    mix(carState, sizeof(carState));
+
+    for (int g = 1; g <= world.gateCount(); ++g) {
+        const std::uint8_t open = world.gateIsOpen(g) ? 1 : 0;
+        mix(&open, 1);
+    }
+
+    const int pickups = world.collectedPickups();
+    const std::uint8_t portal = world.portalTriggered() ? 1 : 0;
+    mix(&pickups, sizeof(pickups));
+    mix(&portal, 1);
+    return h;
+}
@@ -0,0 +1,83 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_INPUTRECORDING_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_INPUTRECORDING_HPP
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Game.hpp"
+#include "InputState.hpp"
+
+// Per-tick input of one run, run-length encoded, plus what is needed to
+// replay it: step length, substepping, level hash, traffic setup and a
+// checksum of the final world state.
+//
+// File: "BREC" header (RecordingHeader, little endian) followed by
+// runCount runs of 5 bytes (u32 ticks, u8 keys). A run of the same keys
+// for minutes of driving is one 5-byte entry.
+class InputRecording {
+public:
+    // keys byte
+    enum : std::uint8_t {
+        Accelerate = 1,
+        Brake = 2,
+        TurnLeft = 4,
+        TurnRight = 8,
+        Reset = 16   // Game::reset() before this tick (R key)
+    };
+
+    struct Run {
+        std::uint32_t ticks;
+        std::uint8_t keys;
+    };
+
+    static std::uint8_t pack(const InputState& input);
+    static InputState unpack(std::uint8_t keys);
+
+    // ---- Recording ----
+    // maxStepDistance/maxSubsteps: the World::setSubstepping of the run
+    void begin(float stepSeconds, std::uint64_t levelHash,
+               std::uint32_t trafficCount = 0, std::uint32_t trafficSeed = 1,
+               float maxStepDistance = 0.f, int maxSubsteps = 8);
+    void markReset() { pendingReset_ = true; }   // applies to the next record()
+    void record(const InputState& input);
+    void finish(const World& world);             // stores the final checksum
+
+    bool save(const std::string& path, std::string* error = nullptr) const;
+    bool load(const std::string& path, std::string* error = nullptr);
+
+    // ---- Replay ----
+    // Runs every recorded tick on game (after a reset, traffic spawn and
+    // the recorded substepping); true if the end state matches the
+    // recorded checksum
+    bool replay(Game& game, std::uint64_t* checksumOut = nullptr) const;
+
+    float stepSeconds() const { return stepSeconds_; }
+    std::uint64_t levelHash() const { return levelHash_; }
+    std::uint32_t trafficCount() const { return trafficCount_; }
+    std::uint32_t trafficSeed() const { return trafficSeed_; }
+    float maxStepDistance() const { return maxStepDistance_; }
+    int maxSubsteps() const { return maxSubsteps_; }
+    std::uint64_t tickCount() const { return tickCount_; }
+    std::uint64_t checksum() const { return checksum_; }
+    const std::vector<Run>& runs() const { return runs_; }
+
+private:
+    float stepSeconds_ = 1.f / 60.f;
+    std::uint64_t levelHash_ = 0;
+    std::uint32_t trafficCount_ = 0;
+    std::uint32_t trafficSeed_ = 1;
+    float maxStepDistance_ = 0.f;
+    int maxSubsteps_ = 8;
+    std::uint64_t tickCount_ = 0;
+    std::uint64_t checksum_ = 0;
+    std::vector<Run> runs_;
+    bool pendingReset_ = false;
+};
+
+// FNV-1a over the car transform and speed, gate states, pickups and portal.
+// Bit exact, so any change in the physics shows up.
+std::uint64_t stateChecksum(const World& world);
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_INPUTRECORDING_HPP
@@ -0,0 +1,67 @@
+#include "InstancedBatch.hpp"
+#include <utility>
+
+using namespace threepp;
+
+InstancedBatch::InstancedBatch(std::shared_ptr<BufferGeometry> geometry, std::shared_ptr<Material> material)
+    : geometry_(std::move(geometry)), material_(std::move(material)) {}
+
+std::size_t InstancedBatch::add(const Vector3& position, const Vector3& scale, float rotationY) {
+    instances_.push_back({position, scale, rotationY, true});
+    return instances_.size() - 1;
+}
+
+std::shared_ptr<InstancedMesh> InstancedBatch::build() {
+    if (instances_.empty()) return nullptr;
+
+    mesh_ = InstancedMesh::create(geometry_, material_, instances_.size());
+    // the bounding volume is the one of the shared geometry, not of the
+    // instances spread over the level, so culling would hide the whole batch
+    mesh_->frustumCulled = false;
+
+    for (std::size_t i = 0; i < instances_.size(); ++i) write(i);
+    mesh_->instanceMatrix()->needsUpdate();
+    changed_ = 0;
+    return mesh_;
+}
+
+void InstancedBatch::setPosition(std::size_t index, const Vector3& position) {
+    if (index >= instances_.size()) return;
+    auto& instance = instances_[index];
+    if (instance.position.x == position.x && instance.position.y == position.y &&
+        instance.position.z == position.z) {
+        return;
+    }
+    instance.position = position;
+    write(index);
+}
+
+void InstancedBatch::setVisible(std::size_t index, bool visible) {
+    if (index >= instances_.size() || instances_[index].visible == visible) return;
+    instances_[index].visible = visible;
+    write(index);
+}
+
+void InstancedBatch::showAll() {
+    for (std::size_t i = 0; i < instances_.size(); ++i) setVisible(i, true);
+}
+
+std::size_t InstancedBatch::commit() {
+    if (!mesh_ || changed_ == 0) return 0;
+    mesh_->instanceMatrix()->needsUpdate();
+    return std::exchange(changed_, 0);
+}
+
+void InstancedBatch::write(std::size_t index) {
+    if (!mesh_) return; // build() writes everything
+
+    const auto& instance = instances_[index];
+    Matrix4 matrix;
+    matrix.makeRotationY(instance.rotationY);
+    // hidden instances collapse to a point instead of leaving the batch
+    matrix.scale(instance.visible ? instance.scale : Vector3(0.f, 0.f, 0.f));
+    matrix.setPosition(instance.position.x, instance.position.y, instance.position.z);
+
+    mesh_->setMatrixAt(index, matrix);
+    changed_++;
+}
@@ -0,0 +1,57 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_INSTANCEDBATCH_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_INSTANCEDBATCH_HPP
+#pragma once
+
+#include <threepp/threepp.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Many copies of one geometry + material drawn as a single InstancedMesh
+// (one draw call for all fences, all pickups, all door panels).
+//
+// Instances are added while the scene is built, then build() creates the
+// mesh. Afterwards they can be moved or hidden (scaled to zero); setting an
+// unchanged value does nothing. commit() uploads the instance matrices once
+// per frame, and only if one changed.
+class InstancedBatch {
+public:
+    static constexpr std::size_t NoInstance = static_cast<std::size_t>(-1);
+
+    InstancedBatch(std::shared_ptr<threepp::BufferGeometry> geometry,
+                   std::shared_ptr<threepp::Material> material);
+
+    // Returns the instance index. Only before build().
+    std::size_t add(const threepp::Vector3& position, const threepp::Vector3& scale, float rotationY = 0.f);
+
+    // Creates the InstancedMesh (nullptr if nothing was added)
+    std::shared_ptr<threepp::InstancedMesh> build();
+
+    std::size_t size() const { return instances_.size(); }
+
+    void setPosition(std::size_t index, const threepp::Vector3& position);
+    void setVisible(std::size_t index, bool visible);
+    void showAll();
+
+    // Returns how many instances were rewritten since the last commit
+    std::size_t commit();
+
+private:
+    struct Instance {
+        threepp::Vector3 position;
+        threepp::Vector3 scale;
+        float rotationY;
+        bool visible;
+    };
+
+    std::shared_ptr<threepp::BufferGeometry> geometry_;
+    std::shared_ptr<threepp::Material> material_;
+    std::shared_ptr<threepp::InstancedMesh> mesh_;
+    std::vector<Instance> instances_;
+    std::size_t changed_ = 0;
+
+    void write(std::size_t index);
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_INSTANCEDBATCH_HPP
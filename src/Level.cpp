@@ -0,0 +1,312 @@
+#include "Level.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+constexpr char Magic[4] = {'B', 'L', 'V', 'L'};
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+}
+
+// -----------------------------------------------------
+// Binary view
+// -----------------------------------------------------
+
+bool LevelView::parse(std::span<const std::byte> bytes, LevelView& out, std::string* error) {
+    if (bytes.size() < sizeof(LevelHeader)) return fail(error, "level file too small");
+    if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(LevelHeader) != 0) {
+        return fail(error, "level data is not aligned");
+    }
+
+    const auto* header = reinterpret_cast<const LevelHeader*>(bytes.data());
+    if (std::memcmp(header->magic, Magic, sizeof(Magic)) != 0) return fail(error, "not a level file");
+    if (header->version != 1 && header->version != LevelFormatVersion) {
+        return fail(error, "unsupported level version");
+    }
+
+    if (header->gateCount > MaxGateCount) return fail(error, "gate count out of range");
+
+    const std::size_t body = bytes.size() - sizeof(LevelHeader);
+    if (body / sizeof(LevelEntity) < header->entityCount) return fail(error, "level file truncated");
+
+    // World indexes its gate table with these numbers
+    const auto* entities = reinterpret_cast<const LevelEntity*>(bytes.data() + sizeof(LevelHeader));
+    for (std::uint32_t i = 0; i < header->entityCount; ++i) {
+        const LevelEntity& e = entities[i];
+        if (e.kind > LevelEntityKind::SizeChange) return fail(error, "unknown entity kind");
+        if (e.gate > header->gateCount) return fail(error, "gate number out of range");
+        if (e.kind == LevelEntityKind::Gate && e.gate < 1) return fail(error, "gate without a number");
+    }
+
+    std::span<const LevelTrigger> triggers;
+    std::span<const LevelTriggerLink> links;
+    if (header->version >= 2) {
+        std::size_t offset = sizeof(LevelHeader) + header->entityCount * sizeof(LevelEntity);
+        if (bytes.size() - offset < sizeof(LevelTriggerTable)) return fail(error, "level file truncated");
+        const auto* table = reinterpret_cast<const LevelTriggerTable*>(bytes.data() + offset);
+        offset += sizeof(LevelTriggerTable);
+
+        const std::size_t tableBytes = std::size_t(table->triggerCount) * sizeof(LevelTrigger) +
+                                       std::size_t(table->linkCount) * sizeof(LevelTriggerLink);
+        if (bytes.size() - offset < tableBytes) return fail(error, "level file truncated");
+
+        triggers = {reinterpret_cast<const LevelTrigger*>(bytes.data() + offset), table->triggerCount};
+        links = {reinterpret_cast<const LevelTriggerLink*>(bytes.data() + offset + triggers.size_bytes()),
+                 table->linkCount};
+        for (const auto& t : triggers) {
+            if (t.trigger < 1 || t.trigger > header->gateCount) return fail(error, "trigger number out of range");
+        }
+        for (const auto& l : links) {
+            if (l.from < 1 || l.from > header->gateCount || l.to < 1 || l.to > header->gateCount) {
+                return fail(error, "trigger link out of range");
+            }
+        }
+    }
+
+    out.header_ = header;
+    out.entities_ = {entities, header->entityCount};
+    out.triggers_ = triggers;
+    out.links_ = links;
+    return true;
+}
+
+std::uint64_t LevelView::hash() const {
+    std::uint64_t h = 14695981039346656037ull;
+    auto mix = [&](const void* data, std::size_t size) {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            h ^= p[i];
+            h *= 1099511628211ull;
+        }
+    };
+    if (header_) mix(header_, sizeof(LevelHeader));
+    mix(entities_.data(), entities_.size_bytes());
+    mix(triggers_.data(), triggers_.size_bytes());
+    mix(links_.data(), links_.size_bytes());
+    return h;
+}
+
+// -----------------------------------------------------
+// Text compiler
+// -----------------------------------------------------
+
+bool compileLevel(std::string_view text, std::vector<std::byte>& out, std::string* error) {
+    LevelHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = LevelFormatVersion;
+
+    std::vector<LevelEntity> entities;
+    std::vector<bool> gateDefined;
+    std::vector<LevelTrigger> triggers;
+    std::vector<LevelTriggerLink> links;
+    std::vector<int> triggerLine;  // per trigger record, for the input check below
+
+    std::istringstream in{std::string(text)};
+    std::string line;
+    int lineNo = 0;
+
+    while (std::getline(in, line)) {
+        ++lineNo;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream ss(line);
+        std::string keyword;
+        if (!(ss >> keyword)) continue; // blank or comment
+
+        auto lineError = [&](const std::string& what) {
+            return fail(error, "line " + std::to_string(lineNo) + ": " + what);
+        };
+
+        LevelEntity e{};
+        int gate = 0;
+        bool ok = true;
+
+        if (keyword == "start") {
+            ok = static_cast<bool>(ss >> header.startX >> header.startZ);
+        } else if (keyword == "portal") {
+            ok = static_cast<bool>(ss >> header.portalX >> header.portalZ
+                                      >> header.portalHalfW >> header.portalHalfL);
+            if (ok && (header.portalHalfW <= 0.f || header.portalHalfL <= 0.f)) {
+                return lineError("portal size must be positive");
+            }
+        } else if (keyword == "pickup") {
+            std::string type;
+            ok = static_cast<bool>(ss >> gate >> type >> e.x >> e.z);
+            if (ok) {
+                if (type == "speed") e.kind = LevelEntityKind::SpeedBoost;
+                else if (type == "size") e.kind = LevelEntityKind::SizeChange;
+                else return lineError("unknown pickup type '" + type + "'");
+                e.halfW = e.halfL = 0.8f;
+            }
+        } else if (keyword == "wall" || keyword == "fence") {
+            e.kind = keyword == "wall" ? LevelEntityKind::Wall : LevelEntityKind::Fence;
+            ok = static_cast<bool>(ss >> e.x >> e.z >> e.halfW >> e.halfL);
+        } else if (keyword == "gate") {
+            e.kind = LevelEntityKind::Gate;
+            ok = static_cast<bool>(ss >> gate >> e.x >> e.z >> e.halfW >> e.halfL);
+            if (ok && gate < 1) return lineError("gate numbers start at 1");
+        } else if (keyword == "trigger") {
+            std::string need;
+            if (!(ss >> gate >> need)) return lineError("expected a number and all|any|<count> after 'trigger'");
+            if (gate < 1 || gate > int(MaxGateCount)) return lineError("trigger number out of range");
+
+            LevelTrigger t{static_cast<std::uint8_t>(gate), 0, 0};
+            if (need == "any") {
+                t.need = 1;
+            } else if (need != "all") {
+                const int count = std::atoi(need.c_str());
+                if (count < 1 || count > 65535 || std::to_string(count) != need) {
+                    return lineError("expected all, any or a count, not '" + need + "'");
+                }
+                t.need = static_cast<std::uint16_t>(count);
+            }
+            for (const auto& other : triggers) {
+                if (other.trigger == t.trigger) return lineError("trigger " + std::to_string(gate) + " defined twice");
+            }
+
+            int from = 0;
+            while (ss >> from) {
+                if (from < 1 || from > int(MaxGateCount)) return lineError("trigger number out of range");
+                if (from == gate) return lineError("trigger " + std::to_string(gate) + " depends on itself");
+                links.push_back({static_cast<std::uint8_t>(from), t.trigger});
+                header.gateCount = std::max(header.gateCount, static_cast<std::uint32_t>(from));
+            }
+            if (!ss.eof()) return lineError("trigger inputs must be trigger numbers");
+
+            triggers.push_back(t);
+            triggerLine.push_back(lineNo);
+            header.gateCount = std::max(header.gateCount, static_cast<std::uint32_t>(gate));
+            continue;
+        } else {
+            return lineError("unknown entity '" + keyword + "'");
+        }
+
+        if (!ok) return lineError("expected more numbers after '" + keyword + "'");
+
+        std::string extra;
+        if (ss >> extra) return lineError("unexpected '" + extra + "'");
+
+        if (keyword == "start" || keyword == "portal") continue;
+
+        if (e.halfW <= 0.f || e.halfL <= 0.f) return lineError("size must be positive");
+        if (gate < 0 || gate > int(MaxGateCount)) return lineError("gate number out of range");
+
+        if (e.kind == LevelEntityKind::Gate) {
+            if (gateDefined.size() < static_cast<std::size_t>(gate)) gateDefined.resize(gate, false);
+            if (gateDefined[gate - 1]) return lineError("gate " + std::to_string(gate) + " defined twice");
+            gateDefined[gate - 1] = true;
+        }
+
+        e.gate = static_cast<std::uint8_t>(gate);
+        header.gateCount = std::max(header.gateCount, static_cast<std::uint32_t>(gate));
+        entities.push_back(e);
+    }
+
+    // a trigger that needs more inputs than it has could never fire
+    for (std::size_t t = 0; t < triggers.size(); ++t) {
+        const auto n = triggers[t].trigger;
+        const auto inputs = std::count_if(entities.begin(), entities.end(), [n](const LevelEntity& e) {
+                                return e.kind != LevelEntityKind::Gate && e.gate == n;
+                            }) +
+                            std::count_if(links.begin(), links.end(), [n](const LevelTriggerLink& l) {
+                                return l.to == n;
+                            });
+        if (inputs == 0 || triggers[t].need > inputs) {
+            return fail(error, "line " + std::to_string(triggerLine[t]) + ": trigger " + std::to_string(n) +
+                               " has only " + std::to_string(inputs) + " inputs");
+        }
+    }
+
+    writeLevel(header, entities, triggers, links, out);
+    return true;
+}
+
+void writeLevel(const LevelHeader& header, std::span<const LevelEntity> entities,
+                std::span<const LevelTrigger> triggers, std::span<const LevelTriggerLink> links,
+                std::vector<std::byte>& out) {
+    // without triggers the version 1 layout is enough (and keeps the hash
+    // of existing levels, which recordings refer to)
+    const bool table = !triggers.empty() || !links.empty();
+
+    LevelHeader h = header;
+    std::memcpy(h.magic, Magic, sizeof(Magic));
+    h.version = table ? LevelFormatVersion : 1;
+    h.entityCount = static_cast<std::uint32_t>(entities.size());
+
+    out.resize(sizeof(LevelHeader) + entities.size_bytes() +
+               (table ? sizeof(LevelTriggerTable) + triggers.size_bytes() + links.size_bytes() : 0));
+    std::byte* at = out.data();
+    auto put = [&at](const void* data, std::size_t size) {
+        if (size > 0) std::memcpy(at, data, size);
+        at += size;
+    };
+
+    put(&h, sizeof(LevelHeader));
+    put(entities.data(), entities.size_bytes());
+    if (table) {
+        const LevelTriggerTable t{static_cast<std::uint32_t>(triggers.size()), static_cast<std::uint32_t>(links.size())};
+        put(&t, sizeof(t));
+        put(triggers.data(), triggers.size_bytes());
+        put(links.data(), links.size_bytes());
+    }
+}
+
+void writeLevel(const LevelHeader& header, std::span<const LevelEntity> entities, std::vector<std::byte>& out) {
+    writeLevel(header, entities, {}, {}, out);
+}
+
+// -----------------------------------------------------
+// Level file
+// -----------------------------------------------------
+
+bool LevelFile::open(const std::string& path, std::string* error) {
+    MappedFile file;
+    if (!file.open(path)) return fail(error, "cannot open " + path);
+
+    const auto bytes = file.bytes();
+    if (bytes.size() >= sizeof(Magic) && std::memcmp(bytes.data(), Magic, sizeof(Magic)) == 0) {
+        LevelView view;
+        if (!LevelView::parse(bytes, view, error)) return false;
+
+        compiled_.clear();
+        mapped_ = std::move(file);
+        view_ = view;
+        return true;
+    }
+
+    // text source: compile it, the mapping is not needed afterwards
+    std::string_view text(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    return loadText(text, error);
+}
+
+bool LevelFile::loadText(std::string_view text, std::string* error) {
+    std::vector<std::byte> compiled;
+    if (!compileLevel(text, compiled, error)) return false;
+    return load(std::move(compiled), error);
+}
+
+bool LevelFile::load(std::vector<std::byte> bytes, std::string* error) {
+    LevelView view;
+    if (!LevelView::parse(bytes, view, error)) return false;
+
+    mapped_.close();
+    compiled_ = std::move(bytes); // moving keeps the buffer, so view stays valid
+    view_ = view;
+    return true;
+}
+
+const LevelFile& LevelFile::defaultLevel() {
+    static const LevelFile level = [] {
+        LevelFile f;
+        f.loadText(defaultLevelText());
+        return f;
+    }();
+    return level;
+}
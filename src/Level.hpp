@@ -0,0 +1,137 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_LEVEL_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_LEVEL_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MappedFile.hpp"
+
+// Level layout shared by World (colliders) and main.cpp (fence/door meshes).
+//
+// Levels are written as text (see levels/default.level for the syntax) and
+// compiled to a binary file: a LevelHeader followed by entityCount
+// LevelEntity records, little endian. Version 2 files add a trigger table
+// after the entities (LevelTriggerTable, then its trigger and link
+// records); levels without triggers are still written as version 1. The
+// binary file is memory-mapped and read in place, without parsing or
+// per-entity allocation.
+
+enum class LevelEntityKind : std::uint8_t {
+    Wall,       // invisible collider
+    Fence,      // collider + fence mesh
+    Gate,       // collider + doors, removed once its trigger fires
+    SpeedBoost, // pickup
+    SizeChange  // pickup
+};
+
+struct LevelEntity {
+    float x, z;
+    float halfW, halfL;
+    LevelEntityKind kind;
+    std::uint8_t gate;        // gate/trigger number for gates and pickups (1..), 0 = none
+    std::uint16_t reserved;
+};
+
+struct LevelHeader {
+    char magic[4];            // "BLVL"
+    std::uint32_t version;
+    std::uint32_t entityCount;
+    std::uint32_t gateCount;  // highest gate/trigger number used
+    float startX, startZ;
+    float portalX, portalZ;
+    float portalHalfW, portalHalfL; // 0 = no portal
+};
+
+// Gates and triggers share their numbers: trigger n opens gate n. Its
+// inputs are the pickups of n plus the triggers linked into it, and it
+// fires once 'need' of them are done. Without a record a trigger needs all
+// of its pickups. Numbers are bytes here and in LevelEntity, so a level
+// has at most MaxGateCount (255) gates and triggers together.
+struct LevelTrigger {
+    std::uint8_t trigger;     // 1..
+    std::uint8_t reserved;
+    std::uint16_t need;       // 0 = all inputs
+};
+
+// Trigger 'from' firing counts as one input of trigger 'to'
+struct LevelTriggerLink {
+    std::uint8_t from;
+    std::uint8_t to;
+};
+
+struct LevelTriggerTable {
+    std::uint32_t triggerCount;
+    std::uint32_t linkCount;
+};
+
+static_assert(sizeof(LevelEntity) == 20, "LevelEntity is part of the file format");
+static_assert(sizeof(LevelHeader) == 40, "LevelHeader is part of the file format");
+static_assert(sizeof(LevelTrigger) == 4 && sizeof(LevelTriggerLink) == 2 && sizeof(LevelTriggerTable) == 8,
+              "trigger records are part of the file format");
+
+constexpr std::uint32_t LevelFormatVersion = 2;  // 1 (no trigger table) is still read
+constexpr std::uint32_t MaxGateCount = 255;      // gate/trigger numbers are bytes
+
+// Typed view over level bytes (the bytes must outlive the view)
+class LevelView {
+public:
+    // Checks magic, version and size before handing out the records
+    static bool parse(std::span<const std::byte> bytes, LevelView& out, std::string* error = nullptr);
+
+    const LevelHeader& header() const { return *header_; }
+    std::span<const LevelEntity> entities() const { return entities_; }
+    std::span<const LevelTrigger> triggers() const { return triggers_; }
+    std::span<const LevelTriggerLink> links() const { return links_; }
+
+    // FNV-1a over header + records (identifies the layout, e.g. in recordings)
+    std::uint64_t hash() const;
+
+private:
+    const LevelHeader* header_ = nullptr;
+    std::span<const LevelEntity> entities_;
+    std::span<const LevelTrigger> triggers_;
+    std::span<const LevelTriggerLink> links_;
+};
+
+// Text source -> binary level. Errors name the offending line.
+bool compileLevel(std::string_view text, std::vector<std::byte>& out, std::string* error = nullptr);
+
+// Header + records -> binary level (magic, version and entityCount are
+// filled in)
+void writeLevel(const LevelHeader& header, std::span<const LevelEntity> entities,
+                std::span<const LevelTrigger> triggers, std::span<const LevelTriggerLink> links,
+                std::vector<std::byte>& out);
+void writeLevel(const LevelHeader& header, std::span<const LevelEntity> entities, std::vector<std::byte>& out);
+
+// levels/default.level, embedded at build time
+std::string_view defaultLevelText();
+
+// Owns the bytes behind a LevelView: a mapping for binary files, a compiled
+// buffer for text sources.
+class LevelFile {
+public:
+    // Binary files (starting with "BLVL") are mapped, anything else is
+    // compiled as level text
+    bool open(const std::string& path, std::string* error = nullptr);
+    bool loadText(std::string_view text, std::string* error = nullptr);
+
+    // Takes over binary level bytes (e.g. from generateLevel)
+    bool load(std::vector<std::byte> bytes, std::string* error = nullptr);
+
+    const LevelView& view() const { return view_; }
+
+    // The embedded default level, compiled once
+    static const LevelFile& defaultLevel();
+
+private:
+    MappedFile mapped_;
+    std::vector<std::byte> compiled_;
+    LevelView view_;
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_LEVEL_HPP
@@ -0,0 +1,104 @@
+#include "LevelGenerator.hpp"
+#include "Level.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+// xorshift32 (as in Fleet), [0, 1)
+float nextFloat(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<float>(state >> 8) * (1.f / 16777216.f);
+}
+
+// the car starts at the origin; nothing is placed inside this square
+constexpr float StartClearance = 15.f;
+
+}
+
+LevelGenParams stressLevelParams(std::size_t colliders, std::uint32_t seed) {
+    LevelGenParams params;
+    params.seed = seed;
+    params.gates = static_cast<std::uint32_t>(std::min<std::size_t>(MaxGateCount, colliders / 100));
+    params.pickups = colliders / 10;
+    params.obstacles = colliders - params.pickups - params.gates;
+    return params;
+}
+
+bool generateLevel(const LevelGenParams& params, std::vector<std::byte>& out, std::string* error) {
+    if (params.gates > MaxGateCount) return fail(error, "at most 255 gates");
+    if (params.spacing <= 0.f) return fail(error, "spacing must be positive");
+
+    const std::size_t total = params.obstacles + params.pickups + params.gates;
+    if (total > 0xFFFFFFFFu - 4) return fail(error, "too many entities");
+
+    std::uint32_t rng = params.seed * 2654435761u ^ 0x9E3779B9u;
+    if (rng == 0) rng = 1;
+
+    const float half = std::max(50.f, 0.5f * params.spacing * std::sqrt(static_cast<float>(total)));
+    const float inner = half - 10.f;
+
+    // a random spot inside the border, away from the start
+    auto place = [&](float& x, float& z) {
+        do {
+            x = (nextFloat(rng) * 2.f - 1.f) * inner;
+            z = (nextFloat(rng) * 2.f - 1.f) * inner;
+        } while (std::abs(x) < StartClearance && std::abs(z) < StartClearance);
+    };
+
+    LevelHeader header{};
+    header.gateCount = params.gates;
+    place(header.portalX, header.portalZ);
+    header.portalHalfW = header.portalHalfL = 6.f;
+
+    std::vector<LevelEntity> entities;
+    entities.reserve(total + 4);
+
+    auto add = [&](LevelEntityKind kind, float x, float z, float halfW, float halfL, std::uint32_t gate) {
+        LevelEntity e{};
+        e.x = x;
+        e.z = z;
+        e.halfW = halfW;
+        e.halfL = halfL;
+        e.kind = kind;
+        e.gate = static_cast<std::uint8_t>(gate);
+        entities.push_back(e);
+    };
+
+    add(LevelEntityKind::Wall, 0.f, half, half, 1.f, 0);
+    add(LevelEntityKind::Wall, 0.f, -half, half, 1.f, 0);
+    add(LevelEntityKind::Wall, -half, 0.f, 1.f, half, 0);
+    add(LevelEntityKind::Wall, half, 0.f, 1.f, half, 0);
+
+    float x, z;
+    for (std::uint32_t g = 1; g <= params.gates; ++g) {
+        place(x, z);
+        add(LevelEntityKind::Gate, x, z, 6.f, 1.f, g);
+    }
+
+    for (std::size_t i = 0; i < params.pickups; ++i) {
+        place(x, z);
+        const auto kind = (i & 1) ? LevelEntityKind::SizeChange : LevelEntityKind::SpeedBoost;
+        const auto gate = params.gates > 0 ? static_cast<std::uint32_t>(i % params.gates) + 1 : 0;
+        add(kind, x, z, 0.8f, 0.8f, gate);
+    }
+
+    // fences: mostly short posts and thin runs, like the default level
+    for (std::size_t i = 0; i < params.obstacles; ++i) {
+        place(x, z);
+        const float length = 0.5f + nextFloat(rng) * 12.f;
+        const float width = 0.5f + nextFloat(rng) * 1.f;
+        if (nextFloat(rng) < 0.5f) add(LevelEntityKind::Fence, x, z, length, width, 0);
+        else add(LevelEntityKind::Fence, x, z, width, length, 0);
+    }
+
+    writeLevel(header, entities, out);
+    return true;
+}
@@ -0,0 +1,32 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_LEVELGENERATOR_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_LEVELGENERATOR_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Seeded procedural levels for stress tests and benchmarks.
+//
+// A square world behind four border walls, filled with randomly placed
+// fences, pickups and gate groups. The side grows with sqrt(colliders), so
+// the collider density (and with it the work per tick near the car) stays
+// about the same from 10 to 1,000,000 colliders. Same parameters, same
+// bytes, on every platform (xorshift, no std distributions).
+struct LevelGenParams {
+    std::uint32_t seed = 1;
+    std::size_t obstacles = 1000;  // fences, not counting the border or gates
+    std::size_t pickups = 100;     // dealt round-robin to the gates, if any
+    std::uint32_t gates = 10;      // 0..255 (the level format stores gate numbers in a byte)
+    float spacing = 20.f;          // metres of world side per sqrt(collider)
+};
+
+// The stress mix used by the tools: a tenth pickups, one gate per 100
+// colliders (at most 255), fences for the rest; plus the 4 border walls
+LevelGenParams stressLevelParams(std::size_t colliders, std::uint32_t seed);
+
+// Writes a binary level (see Level.hpp); false for out-of-range parameters
+bool generateLevel(const LevelGenParams& params, std::vector<std::byte>& out, std::string* error = nullptr);
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_LEVELGENERATOR_HPP
@@ -0,0 +1,18 @@
+#include "LodPolicy.hpp"
+#include <utility>
+
+LodPolicy::LodPolicy(std::vector<float> distances, float hysteresis)
+    : distances_(std::move(distances)), hysteresis_(hysteresis) {}
+
+int LodPolicy::select(float distance, int current) const {
+    const int n = levels();
+    if (current == Culled || current > n) current = n;
+
+    // boundaries behind the current level move in, those ahead move out
+    int level = 0;
+    for (int i = 0; i < n; ++i) {
+        const float boundary = distances_[i] + (i < current ? -hysteresis_ : hysteresis_);
+        if (distance >= boundary) level = i + 1;
+    }
+    return level == n ? Culled : level;
+}
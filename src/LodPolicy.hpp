@@ -0,0 +1,32 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_LODPOLICY_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_LODPOLICY_HPP
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Picks a level of detail from the camera distance.
+//
+// Level i is used up to distances[i]; past the last distance the object is
+// culled. A level only changes once the distance is `hysteresis` beyond
+// the boundary, so an object sitting on a boundary does not flicker
+// between two levels while the chase camera sways.
+class LodPolicy {
+public:
+    static constexpr int Culled = -1;
+
+    LodPolicy() = default;
+    // distances must be increasing
+    explicit LodPolicy(std::vector<float> distances, float hysteresis = 0.f);
+
+    // current: the level picked last time (Culled for culled)
+    int select(float distance, int current) const;
+
+    int levels() const { return static_cast<int>(distances_.size()); }
+
+private:
+    std::vector<float> distances_;
+    float hysteresis_ = 0.f;
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_LODPOLICY_HPP
@@ -0,0 +1,43 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_MAPPEDFILE_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_MAPPEDFILE_HPP
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+// Read-only memory mapping of a whole file (mmap / MapViewOfFile).
+// The bytes stay valid until close() or destruction; moving keeps them valid.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Fails for missing or empty files
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+    const std::byte* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    std::span<const std::byte> bytes() const { return {data_, size_}; }
+
+private:
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+
+#if defined(_WIN32)
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+
+    void swap(MappedFile& other) noexcept;
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_MAPPEDFILE_HPP
@@ -0,0 +1,620 @@
+#include "MeshCache.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+
+namespace {
+
+constexpr char Magic[4] = {'B', 'M', 'S', 'H'};
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+// -----------------------------------------------------
+// Text helpers
+// -----------------------------------------------------
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Splits off the next whitespace separated token
+std::string_view nextToken(std::string_view& line) {
+    std::size_t begin = 0;
+    while (begin < line.size() && isSpace(line[begin])) ++begin;
+    std::size_t end = begin;
+    while (end < line.size() && !isSpace(line[end])) ++end;
+    std::string_view token = line.substr(begin, end - begin);
+    line.remove_prefix(end);
+    return token;
+}
+
+// Rest of the line without surrounding whitespace (names may contain spaces)
+std::string_view restOfLine(std::string_view line) {
+    while (!line.empty() && isSpace(line.front())) line.remove_prefix(1);
+    while (!line.empty() && isSpace(line.back())) line.remove_suffix(1);
+    return line;
+}
+
+bool parseFloat(std::string_view token, float& out) {
+    if (!token.empty() && token.front() == '+') token.remove_prefix(1);
+    auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), out);
+    return ec == std::errc{} && ptr == token.data() + token.size();
+}
+
+bool parseInt(std::string_view token, int& out) {
+    auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), out);
+    return ec == std::errc{} && ptr == token.data() + token.size();
+}
+
+template<class Fn>
+void forEachLine(std::string_view text, Fn&& fn) {
+    int lineNo = 0;
+    while (!text.empty()) {
+        const std::size_t end = std::min(text.find('\n'), text.size());
+        std::string_view line = text.substr(0, end);
+        text.remove_prefix(std::min(end + 1, text.size()));
+        line = line.substr(0, line.find('#'));
+        if (!fn(++lineNo, line)) return;
+    }
+}
+
+// OBJ indices are 1-based, negative ones count back from the end
+bool resolveIndex(std::string_view token, std::size_t count, int& out) {
+    int i = 0;
+    if (!parseInt(token, i) || i == 0) return false;
+    i = i > 0 ? i - 1 : static_cast<int>(count) + i;
+    if (i < 0 || static_cast<std::size_t>(i) >= count) return false;
+    out = i;
+    return true;
+}
+
+struct VertexKey {
+    int v, vt, vn;
+    bool operator==(const VertexKey&) const = default;
+};
+
+struct VertexKeyHash {
+    std::size_t operator()(const VertexKey& k) const {
+        return (static_cast<std::size_t>(k.v) * 73856093u) ^
+               (static_cast<std::size_t>(k.vt + 1) * 19349663u) ^
+               (static_cast<std::size_t>(k.vn + 1) * 83492791u);
+    }
+};
+
+bool readFile(const std::string& path, MappedFile& file, std::string_view& text) {
+    if (!file.open(path)) return false;
+    text = {reinterpret_cast<const char*>(file.data()), file.size()};
+    return true;
+}
+
+// mtllib names as written in the OBJ
+std::vector<std::string> mtlLibraries(std::string_view obj) {
+    std::vector<std::string> libs;
+    forEachLine(obj, [&](int, std::string_view line) {
+        if (nextToken(line) == "mtllib") {
+            for (auto name = nextToken(line); !name.empty(); name = nextToken(line)) {
+                libs.emplace_back(name);
+            }
+        }
+        return true;
+    });
+    return libs;
+}
+
+// Kenney's MTL files say Textures/ while the folder is textures/; accept
+// either spelling so the maps are found on case-sensitive file systems
+std::string resolveTexture(const std::filesystem::path& dir, const std::string& name) {
+    namespace fs = std::filesystem;
+    const fs::path direct = dir / name;
+    if (fs::exists(direct)) return direct.generic_string();
+
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    const fs::path folded = dir / lower;
+    if (fs::exists(folded)) return folded.generic_string();
+    return direct.generic_string();
+}
+
+std::size_t align4(std::size_t n) {
+    return (n + 3) & ~std::size_t{3};
+}
+
+}
+
+// -----------------------------------------------------
+// OBJ / MTL text
+// -----------------------------------------------------
+
+bool parseObj(std::string_view obj, std::string_view mtl, MeshData& out, std::string* error) {
+    out = MeshData{};
+
+    // MTL: only what the renderer uses (diffuse color and map)
+    std::unordered_map<std::string, std::uint32_t> materialIndex;
+    forEachLine(mtl, [&](int, std::string_view line) {
+        const std::string_view keyword = nextToken(line);
+        if (keyword == "newmtl") {
+            std::string name(restOfLine(line));
+            materialIndex[name] = static_cast<std::uint32_t>(out.materials.size());
+            out.materials.push_back({name});
+        } else if (!out.materials.empty() && keyword == "Kd") {
+            for (float& c : out.materials.back().diffuse) {
+                if (!parseFloat(nextToken(line), c)) c = 1.f;
+            }
+        } else if (!out.materials.empty() && keyword == "map_Kd") {
+            // options (-s, -o, ...) are not supported; the file name comes last
+            std::string_view name;
+            for (auto t = nextToken(line); !t.empty(); t = nextToken(line)) name = t;
+            out.materials.back().diffuseMap = std::string(name);
+        }
+        return true;
+    });
+
+    std::vector<float> positions, uvs, normals;
+    std::unordered_map<VertexKey, std::uint32_t, VertexKeyHash> vertexIndex;
+    std::vector<VertexKey> corners;
+    bool anyNormals = false, anyUvs = false;
+    std::uint32_t currentMaterial = UINT32_MAX;
+    std::string message;
+
+    forEachLine(obj, [&](int lineNo, std::string_view line) {
+        auto lineError = [&](const std::string& what) {
+            message = "line " + std::to_string(lineNo) + ": " + what;
+            return false;
+        };
+
+        const std::string_view keyword = nextToken(line);
+
+        if (keyword == "v" || keyword == "vn" || keyword == "vt") {
+            auto& target = keyword == "v" ? positions : keyword == "vn" ? normals : uvs;
+            const int components = keyword == "vt" ? 2 : 3;
+            for (int c = 0; c < components; ++c) {
+                float value = 0.f;
+                if (!parseFloat(nextToken(line), value)) {
+                    return lineError("expected " + std::to_string(components) + " numbers after '" +
+                                     std::string(keyword) + "'");
+                }
+                target.push_back(value);
+            }
+            // extra values (w, vertex colors) are ignored
+        } else if (keyword == "usemtl") {
+            const std::string name(restOfLine(line));
+            auto it = materialIndex.find(name);
+            if (it == materialIndex.end()) {
+                it = materialIndex.emplace(name, static_cast<std::uint32_t>(out.materials.size())).first;
+                out.materials.push_back({name});
+            }
+            currentMaterial = it->second;
+        } else if (keyword == "f") {
+            corners.clear();
+            for (auto token = nextToken(line); !token.empty(); token = nextToken(line)) {
+                VertexKey key{-1, -1, -1};
+                const std::size_t s1 = token.find('/');
+                const std::size_t s2 = s1 == std::string_view::npos ? s1 : token.find('/', s1 + 1);
+
+                bool ok = resolveIndex(token.substr(0, s1), positions.size() / 3, key.v);
+                if (ok && s1 != std::string_view::npos) {
+                    const auto vt = token.substr(s1 + 1, s2 == std::string_view::npos ? s2 : s2 - s1 - 1);
+                    if (!vt.empty()) ok = resolveIndex(vt, uvs.size() / 2, key.vt);
+                }
+                if (ok && s2 != std::string_view::npos) {
+                    ok = resolveIndex(token.substr(s2 + 1), normals.size() / 3, key.vn);
+                }
+                if (!ok) return lineError("bad face vertex '" + std::string(token) + "'");
+                corners.push_back(key);
+            }
+            if (corners.size() < 3) return lineError("face needs at least 3 vertices");
+
+            if (currentMaterial == UINT32_MAX) {
+                currentMaterial = static_cast<std::uint32_t>(out.materials.size());
+                out.materials.push_back({"default"});
+            }
+            if (out.groups.empty() || out.groups.back().material != currentMaterial) {
+                out.groups.push_back({static_cast<std::uint32_t>(out.indices.size()), 0, currentMaterial});
+            }
+
+            auto vertex = [&](const VertexKey& key) {
+                auto [it, inserted] = vertexIndex.try_emplace(key, static_cast<std::uint32_t>(out.vertexCount()));
+                if (inserted) {
+                    out.positions.insert(out.positions.end(), &positions[3 * key.v], &positions[3 * key.v] + 3);
+                    if (key.vn >= 0) {
+                        out.normals.insert(out.normals.end(), &normals[3 * key.vn], &normals[3 * key.vn] + 3);
+                        anyNormals = true;
+                    } else {
+                        out.normals.insert(out.normals.end(), 3, 0.f);
+                    }
+                    if (key.vt >= 0) {
+                        out.uvs.insert(out.uvs.end(), &uvs[2 * key.vt], &uvs[2 * key.vt] + 2);
+                        anyUvs = true;
+                    } else {
+                        out.uvs.insert(out.uvs.end(), 2, 0.f);
+                    }
+                }
+                out.indices.push_back(it->second);
+            };
+
+            // convex polygons: triangle fan around the first corner
+            for (std::size_t i = 1; i + 1 < corners.size(); ++i) {
+                vertex(corners[0]);
+                vertex(corners[i]);
+                vertex(corners[i + 1]);
+                out.groups.back().count += 3;
+            }
+        }
+        // g, o, s, mtllib and unknown keywords carry nothing the renderer needs
+        return true;
+    });
+
+    if (!message.empty()) return fail(error, message);
+
+    if (!anyNormals) out.normals.clear();
+    if (!anyUvs) out.uvs.clear();
+    return true;
+}
+
+bool loadObj(const std::string& objPath, MeshData& out, std::string* error) {
+    MappedFile objFile;
+    std::string_view objText;
+    if (!readFile(objPath, objFile, objText)) return fail(error, "cannot open " + objPath);
+
+    const std::filesystem::path dir = std::filesystem::path(objPath).parent_path();
+
+    std::string mtlText;
+    for (const auto& lib : mtlLibraries(objText)) {
+        MappedFile mtlFile;
+        std::string_view text;
+        if (!readFile((dir / lib).string(), mtlFile, text)) return fail(error, "cannot open " + (dir / lib).string());
+        mtlText.append(text).push_back('\n');
+    }
+
+    if (!parseObj(objText, mtlText, out, error)) {
+        if (error) *error = objPath + ": " + *error;
+        return false;
+    }
+
+    for (auto& m : out.materials) {
+        if (!m.diffuseMap.empty()) m.diffuseMap = resolveTexture(dir, m.diffuseMap);
+    }
+    return true;
+}
+
+std::uint64_t objSourceHash(const std::string& objPath) {
+    std::uint64_t h = 14695981039346656037ull;
+    auto mix = [&](std::string_view bytes) {
+        for (unsigned char c : bytes) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+    };
+
+    MappedFile objFile;
+    std::string_view objText;
+    if (!readFile(objPath, objFile, objText)) return 0;
+    mix(objText);
+
+    const std::filesystem::path dir = std::filesystem::path(objPath).parent_path();
+    for (const auto& lib : mtlLibraries(objText)) {
+        MappedFile mtlFile;
+        std::string_view text;
+        mix(lib);
+        if (readFile((dir / lib).string(), mtlFile, text)) mix(text);
+    }
+    return h;
+}
+
+// -----------------------------------------------------
+// Level of detail
+// -----------------------------------------------------
+
+void simplifyMesh(const MeshData& in, float cellSize, MeshData& out) {
+    out = MeshData{};
+    out.materials = in.materials;
+
+    const std::size_t vertexCount = in.vertexCount();
+    if (vertexCount == 0 || cellSize <= 0.f) {
+        out = in;
+        return;
+    }
+
+    float lo[3] = {in.positions[0], in.positions[1], in.positions[2]};
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        for (int c = 0; c < 3; ++c) lo[c] = std::min(lo[c], in.positions[3 * v + c]);
+    }
+
+    struct ClusterKey {
+        int x, y, z;
+        float u, v;
+        bool operator==(const ClusterKey&) const = default;
+    };
+    struct ClusterKeyHash {
+        std::size_t operator()(const ClusterKey& k) const {
+            std::uint32_t u, v;
+            std::memcpy(&u, &k.u, 4);
+            std::memcpy(&v, &k.v, 4);
+            return (static_cast<std::size_t>(k.x) * 73856093u) ^ (static_cast<std::size_t>(k.y) * 19349663u) ^
+                   (static_cast<std::size_t>(k.z) * 83492791u) ^ (static_cast<std::size_t>(u) * 2654435761u) ^
+                   v;
+        }
+    };
+
+    const bool hasNormals = !in.normals.empty();
+    const bool hasUvs = !in.uvs.empty();
+
+    std::unordered_map<ClusterKey, std::uint32_t, ClusterKeyHash> clusterIndex;
+    std::vector<std::uint32_t> cluster(vertexCount);
+    std::vector<std::uint32_t> members;
+
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        const float* p = &in.positions[3 * v];
+        ClusterKey key{static_cast<int>((p[0] - lo[0]) / cellSize),
+                       static_cast<int>((p[1] - lo[1]) / cellSize),
+                       static_cast<int>((p[2] - lo[2]) / cellSize),
+                       hasUvs ? in.uvs[2 * v] : 0.f,
+                       hasUvs ? in.uvs[2 * v + 1] : 0.f};
+
+        auto [it, inserted] = clusterIndex.try_emplace(key, static_cast<std::uint32_t>(members.size()));
+        if (inserted) {
+            members.push_back(0);
+            out.positions.insert(out.positions.end(), 3, 0.f);
+            if (hasNormals) out.normals.insert(out.normals.end(), 3, 0.f);
+            if (hasUvs) out.uvs.insert(out.uvs.end(), {key.u, key.v});
+        }
+
+        // sums for now, averaged below
+        const std::uint32_t c = it->second;
+        cluster[v] = c;
+        members[c]++;
+        for (int k = 0; k < 3; ++k) {
+            out.positions[3 * c + k] += p[k];
+            if (hasNormals) out.normals[3 * c + k] += in.normals[3 * v + k];
+        }
+    }
+
+    for (std::size_t c = 0; c < members.size(); ++c) {
+        for (int k = 0; k < 3; ++k) out.positions[3 * c + k] /= static_cast<float>(members[c]);
+        if (hasNormals) {
+            float* n = &out.normals[3 * c];
+            const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length > 0.f) {
+                for (int k = 0; k < 3; ++k) n[k] /= length;
+            }
+        }
+    }
+
+    for (const auto& group : in.groups) {
+        MeshGroup g{static_cast<std::uint32_t>(out.indices.size()), 0, group.material};
+        const std::size_t end = std::min<std::size_t>(std::size_t{group.start} + group.count, in.indices.size());
+        for (std::size_t i = group.start; i + 3 <= end; i += 3) {
+            const std::uint32_t a = cluster[in.indices[i]];
+            const std::uint32_t b = cluster[in.indices[i + 1]];
+            const std::uint32_t c = cluster[in.indices[i + 2]];
+            if (a == b || b == c || a == c) continue; // collapsed
+            out.indices.insert(out.indices.end(), {a, b, c});
+            g.count += 3;
+        }
+        if (g.count > 0) out.groups.push_back(g);
+    }
+}
+
+float meshLodCellFraction(int lod) {
+    switch (lod) {
+        case 0: return 0.f;
+        case 1: return 1.f / 16.f;
+        default: return 1.f / 6.f;
+    }
+}
+
+std::uint64_t meshLodSourceHash(std::uint64_t sourceHash, int lod) {
+    if (lod <= 0) return sourceHash;
+
+    std::uint64_t h = sourceHash;
+    auto mix = [&](const void* data, std::size_t size) {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            h ^= p[i];
+            h *= 1099511628211ull;
+        }
+    };
+    const float fraction = meshLodCellFraction(lod);
+    mix(&lod, sizeof(lod));
+    mix(&fraction, sizeof(fraction));
+    mix(&MeshSimplifyVersion, sizeof(MeshSimplifyVersion));
+    return h;
+}
+
+// -----------------------------------------------------
+// Binary cache
+// -----------------------------------------------------
+
+void writeMeshCache(const MeshData& mesh, std::uint64_t sourceHash, std::vector<std::byte>& out) {
+    const std::uint32_t vertexCount = static_cast<std::uint32_t>(mesh.vertexCount());
+    const bool hasNormals = !mesh.normals.empty();
+    const bool hasUvs = !mesh.uvs.empty();
+
+    std::string strings;
+    std::vector<MeshCacheMaterial> materials;
+    for (const auto& m : mesh.materials) {
+        MeshCacheMaterial record{};
+        std::memcpy(record.diffuse, m.diffuse, sizeof(record.diffuse));
+        record.nameOffset = static_cast<std::uint32_t>(strings.size());
+        record.nameLength = static_cast<std::uint32_t>(m.name.size());
+        strings += m.name;
+        record.mapOffset = static_cast<std::uint32_t>(strings.size());
+        record.mapLength = static_cast<std::uint32_t>(m.diffuseMap.size());
+        strings += m.diffuseMap;
+        materials.push_back(record);
+    }
+
+    MeshCacheHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = MeshCacheVersion;
+    header.sourceHash = sourceHash;
+    header.vertexCount = vertexCount;
+    header.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+    header.groupCount = static_cast<std::uint32_t>(mesh.groups.size());
+    header.materialCount = static_cast<std::uint32_t>(materials.size());
+    header.flags = (hasNormals ? MeshCacheHasNormals : 0) | (hasUvs ? MeshCacheHasUvs : 0);
+    header.stringBytes = static_cast<std::uint32_t>(strings.size());
+
+    out.clear();
+    auto append = [&](const void* data, std::size_t size) {
+        const auto* p = static_cast<const std::byte*>(data);
+        out.insert(out.end(), p, p + size);
+    };
+
+    append(&header, sizeof(header));
+    append(mesh.positions.data(), mesh.positions.size() * sizeof(float));
+    if (hasNormals) append(mesh.normals.data(), mesh.normals.size() * sizeof(float));
+    if (hasUvs) append(mesh.uvs.data(), mesh.uvs.size() * sizeof(float));
+    append(mesh.indices.data(), mesh.indices.size() * sizeof(std::uint32_t));
+    append(mesh.groups.data(), mesh.groups.size() * sizeof(MeshGroup));
+    append(materials.data(), materials.size() * sizeof(MeshCacheMaterial));
+    append(strings.data(), strings.size());
+    out.resize(align4(out.size()));
+}
+
+bool MeshView::parse(std::span<const std::byte> bytes, MeshView& out, std::string* error) {
+    if (bytes.size() < sizeof(MeshCacheHeader)) return fail(error, "mesh cache too small");
+    if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(MeshCacheHeader) != 0) {
+        return fail(error, "mesh cache data is not aligned");
+    }
+
+    const auto* header = reinterpret_cast<const MeshCacheHeader*>(bytes.data());
+    if (std::memcmp(header->magic, Magic, sizeof(Magic)) != 0) return fail(error, "not a mesh cache");
+    if (header->version != MeshCacheVersion) return fail(error, "unsupported mesh cache version");
+
+    const std::uint64_t v = header->vertexCount;
+    const std::uint64_t floats = v * 3 +
+                                 ((header->flags & MeshCacheHasNormals) ? v * 3 : 0) +
+                                 ((header->flags & MeshCacheHasUvs) ? v * 2 : 0);
+    const std::uint64_t needed = sizeof(MeshCacheHeader) + floats * sizeof(float) +
+                                 std::uint64_t{header->indexCount} * sizeof(std::uint32_t) +
+                                 std::uint64_t{header->groupCount} * sizeof(MeshGroup) +
+                                 std::uint64_t{header->materialCount} * sizeof(MeshCacheMaterial) +
+                                 header->stringBytes;
+    if (bytes.size() < needed) return fail(error, "mesh cache truncated");
+
+    const std::byte* p = bytes.data() + sizeof(MeshCacheHeader);
+    auto take = [&](auto& span, std::size_t count) {
+        using T = typename std::remove_reference_t<decltype(span)>::element_type;
+        span = {reinterpret_cast<T*>(p), count};
+        p += count * sizeof(T);
+    };
+
+    MeshView view;
+    view.header_ = header;
+    take(view.positions_, v * 3);
+    if (header->flags & MeshCacheHasNormals) take(view.normals_, v * 3);
+    if (header->flags & MeshCacheHasUvs) take(view.uvs_, v * 2);
+    take(view.indices_, header->indexCount);
+    take(view.groups_, header->groupCount);
+    take(view.materials_, header->materialCount);
+    view.strings_ = {reinterpret_cast<const char*>(p), header->stringBytes};
+
+    for (std::uint32_t i : view.indices_) {
+        if (i >= v) return fail(error, "mesh cache index out of range");
+    }
+    for (const auto& g : view.groups_) {
+        if (std::uint64_t{g.start} + g.count > header->indexCount || g.material >= header->materialCount) {
+            return fail(error, "mesh cache group out of range");
+        }
+    }
+    for (const auto& m : view.materials_) {
+        if (std::uint64_t{m.nameOffset} + m.nameLength > header->stringBytes ||
+            std::uint64_t{m.mapOffset} + m.mapLength > header->stringBytes) {
+            return fail(error, "mesh cache material out of range");
+        }
+    }
+
+    out = view;
+    return true;
+}
+
+std::string_view MeshView::materialName(std::size_t i) const {
+    return strings_.substr(materials_[i].nameOffset, materials_[i].nameLength);
+}
+
+std::string_view MeshView::materialMap(std::size_t i) const {
+    return strings_.substr(materials_[i].mapOffset, materials_[i].mapLength);
+}
+
+// -----------------------------------------------------
+// Mesh file
+// -----------------------------------------------------
+
+bool MeshFile::open(const std::string& objPath, const std::string& cacheDir, std::string* error) {
+    return open(objPath, cacheDir, 0, error);
+}
+
+bool MeshFile::open(const std::string& objPath, const std::string& cacheDir, int lod, std::string* error) {
+    namespace fs = std::filesystem;
+
+    const std::uint64_t objHash = objSourceHash(objPath);
+    if (objHash == 0) return fail(error, "cannot open " + objPath);
+    // a simplified level is stale when the simplifier or its cell changes too
+    const std::uint64_t sourceHash = meshLodSourceHash(objHash, lod);
+
+    const std::string suffix = lod > 0 ? ".lod" + std::to_string(lod) + ".bmesh" : ".bmesh";
+    const fs::path cachePath = fs::path(cacheDir) / (fs::path(objPath).stem().string() + suffix);
+
+    MappedFile cached;
+    MeshView view;
+    if (cached.open(cachePath.string()) && MeshView::parse(cached.bytes(), view) &&
+        view.sourceHash() == sourceHash) {
+        built_.clear();
+        mapped_ = std::move(cached);
+        view_ = view;
+        fromCache_ = true;
+        return true;
+    }
+    cached.close();
+
+    MeshData mesh;
+    if (!loadObj(objPath, mesh, error)) return false;
+
+    if (lod > 0 && mesh.vertexCount() > 0) {
+        float lo[3], hi[3];
+        for (int c = 0; c < 3; ++c) lo[c] = hi[c] = mesh.positions[c];
+        for (std::size_t i = 0; i < mesh.positions.size(); ++i) {
+            lo[i % 3] = std::min(lo[i % 3], mesh.positions[i]);
+            hi[i % 3] = std::max(hi[i % 3], mesh.positions[i]);
+        }
+        const float extent = std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+
+        MeshData simplified;
+        simplifyMesh(mesh, extent * meshLodCellFraction(lod), simplified);
+        mesh = std::move(simplified);
+    }
+
+    std::vector<std::byte> bytes;
+    writeMeshCache(mesh, sourceHash, bytes);
+    if (!MeshView::parse(bytes, view, error)) return false;
+
+    // best effort: without a writable cache directory every start parses
+    std::error_code ec;
+    fs::create_directories(cacheDir, ec);
+    {
+        const fs::path tmp = cachePath.string() + ".tmp";
+        std::ofstream out(tmp, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        out.close();
+        if (out) fs::rename(tmp, cachePath, ec);
+        else fs::remove(tmp, ec);
+    }
+
+    mapped_.close();
+    built_ = std::move(bytes); // moving keeps the buffer, so view stays valid
+    view_ = view;
+    fromCache_ = false;
+    return true;
+}
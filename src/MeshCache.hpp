@@ -0,0 +1,168 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_MESHCACHE_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_MESHCACHE_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MappedFile.hpp"
+
+// Models (objmodels/*.obj) without the text parsing on every start.
+//
+// The first start parses the OBJ/MTL text once and writes a binary cache
+// next to it (objmodels/cache/<name>.bmesh): indexed vertex buffers, the
+// material groups and the materials, tagged with a hash of the source files.
+// Later starts map the cache and hand its arrays straight to the renderer;
+// the cache is rebuilt when the hash no longer matches.
+
+struct MeshGroup {
+    std::uint32_t start;      // first index
+    std::uint32_t count;      // number of indices
+    std::uint32_t material;   // index into the materials
+};
+
+struct MeshMaterial {
+    std::string name;
+    float diffuse[3] = {1.f, 1.f, 1.f};
+    std::string diffuseMap;   // texture path, empty = none
+};
+
+// Parsed model: one vertex per unique position/uv/normal combination
+struct MeshData {
+    std::vector<float> positions;       // xyz
+    std::vector<float> normals;         // xyz, empty if the OBJ has none
+    std::vector<float> uvs;             // uv, empty if the OBJ has none
+    std::vector<std::uint32_t> indices; // triangles
+    std::vector<MeshGroup> groups;
+    std::vector<MeshMaterial> materials;
+
+    std::size_t vertexCount() const { return positions.size() / 3; }
+};
+
+// OBJ + MTL text -> MeshData. Polygons are split into triangles; errors name
+// the offending OBJ line. Texture paths are kept as written in the MTL.
+bool parseObj(std::string_view obj, std::string_view mtl, MeshData& out, std::string* error = nullptr);
+
+// Reads objPath and its mtllib files; texture paths come out relative to
+// the working directory.
+bool loadObj(const std::string& objPath, MeshData& out, std::string* error = nullptr);
+
+// FNV-1a over the OBJ and the MTL files it names
+std::uint64_t objSourceHash(const std::string& objPath);
+
+// -----------------------------------------------------
+// Level of detail
+// -----------------------------------------------------
+
+// Vertex clustering: vertices that share a grid cell of cellSize (and the
+// same uv, so palette colors stay put) merge into one, and triangles that
+// collapse are dropped. Groups and materials are kept.
+void simplifyMesh(const MeshData& in, float cellSize, MeshData& out);
+
+// Level 0 is the full mesh; level n is clustered with a cell of
+// meshLodCellFraction(n) times the model's largest extent
+constexpr int MeshLodLevels = 3;
+float meshLodCellFraction(int lod);
+
+// Bump when simplifyMesh changes its output, so cached levels are rebuilt
+constexpr std::uint32_t MeshSimplifyVersion = 1;
+
+// Hash a cached level is checked against: the source hash for level 0;
+// simplified levels also mix in the level, its cell fraction and
+// MeshSimplifyVersion
+std::uint64_t meshLodSourceHash(std::uint64_t sourceHash, int lod);
+
+// -----------------------------------------------------
+// Binary cache
+// -----------------------------------------------------
+
+struct MeshCacheHeader {
+    char magic[4];            // "BMSH"
+    std::uint32_t version;
+    std::uint64_t sourceHash;
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;
+    std::uint32_t groupCount;
+    std::uint32_t materialCount;
+    std::uint32_t flags;      // MeshCacheHasNormals | MeshCacheHasUvs
+    std::uint32_t stringBytes;
+};
+
+// Follows the groups; the names live in the string block at the end
+struct MeshCacheMaterial {
+    float diffuse[3];
+    std::uint32_t nameOffset, nameLength;
+    std::uint32_t mapOffset, mapLength;
+};
+
+static_assert(sizeof(MeshCacheHeader) == 40, "MeshCacheHeader is part of the file format");
+static_assert(sizeof(MeshGroup) == 12, "MeshGroup is part of the file format");
+static_assert(sizeof(MeshCacheMaterial) == 28, "MeshCacheMaterial is part of the file format");
+
+constexpr std::uint32_t MeshCacheVersion = 1;
+constexpr std::uint32_t MeshCacheHasNormals = 1;
+constexpr std::uint32_t MeshCacheHasUvs = 2;
+
+// MeshData -> cache bytes: header, positions, normals, uvs, indices, groups,
+// materials, strings (little endian, every block 4-byte aligned)
+void writeMeshCache(const MeshData& mesh, std::uint64_t sourceHash, std::vector<std::byte>& out);
+
+// Typed view over cache bytes (the bytes must outlive the view)
+class MeshView {
+public:
+    static bool parse(std::span<const std::byte> bytes, MeshView& out, std::string* error = nullptr);
+
+    const MeshCacheHeader& header() const { return *header_; }
+    std::uint64_t sourceHash() const { return header_ ? header_->sourceHash : 0; }
+
+    std::span<const float> positions() const { return positions_; }
+    std::span<const float> normals() const { return normals_; }
+    std::span<const float> uvs() const { return uvs_; }
+    std::span<const std::uint32_t> indices() const { return indices_; }
+    std::span<const MeshGroup> groups() const { return groups_; }
+
+    std::size_t materialCount() const { return materials_.size(); }
+    const float* materialDiffuse(std::size_t i) const { return materials_[i].diffuse; }
+    std::string_view materialName(std::size_t i) const;
+    std::string_view materialMap(std::size_t i) const;
+
+private:
+    const MeshCacheHeader* header_ = nullptr;
+    std::span<const float> positions_;
+    std::span<const float> normals_;
+    std::span<const float> uvs_;
+    std::span<const std::uint32_t> indices_;
+    std::span<const MeshGroup> groups_;
+    std::span<const MeshCacheMaterial> materials_;
+    std::string_view strings_;
+};
+
+// Owns the bytes behind a MeshView: a mapping of a valid cache file, or the
+// freshly built bytes after a cache miss.
+class MeshFile {
+public:
+    // Maps cacheDir/<obj name>.bmesh if it was built from the current
+    // source; otherwise parses the OBJ and rewrites the cache (a cache that
+    // cannot be written is not an error).
+    bool open(const std::string& objPath, const std::string& cacheDir, std::string* error = nullptr);
+
+    // Same for a simplified level (cacheDir/<obj name>.lod<n>.bmesh)
+    bool open(const std::string& objPath, const std::string& cacheDir, int lod, std::string* error = nullptr);
+
+    const MeshView& view() const { return view_; }
+
+    // true if the last open() was served from the cache file
+    bool fromCache() const { return fromCache_; }
+
+private:
+    MappedFile mapped_;
+    std::vector<std::byte> built_;
+    MeshView view_;
+    bool fromCache_ = false;
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_MESHCACHE_HPP
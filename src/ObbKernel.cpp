@@ -0,0 +1,200 @@
+#include "ObbKernel.hpp"
+#include "AabbKernel.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BILSIM_KERNEL_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BILSIM_KERNEL_SSE2 1
+#endif
+
+namespace {
+
+// The car axes for one box, in the operation order every SIMD path uses
+inline bool carAxesOverlap(const Car::OBB& car, float minX, float maxX, float minZ, float maxZ) {
+    const float ax = std::abs(car.forwardX);
+    const float az = std::abs(car.forwardZ);
+
+    const float ex = (maxX - minX) * 0.5f;
+    const float ez = (maxZ - minZ) * 0.5f;
+    const float dx = car.x - (minX + maxX) * 0.5f;
+    const float dz = car.z - (minZ + maxZ) * 0.5f;
+
+    // forward axis (forwardX, forwardZ), side axis (forwardZ, -forwardX)
+    const float along = std::abs(dx * car.forwardX + dz * car.forwardZ);
+    const float across = std::abs(dx * car.forwardZ - dz * car.forwardX);
+    return along <= car.halfL + (ex * ax + ez * az) &&
+           across <= car.halfW + (ex * az + ez * ax);
+}
+
+inline bool enclosingOverlaps(const Car::AABB& a, float minX, float maxX, float minZ, float maxZ) {
+    return a.minX <= maxX && a.maxX >= minX &&
+           a.minZ <= maxZ && a.maxZ >= minZ;
+}
+
+void clearMask(std::size_t count, std::uint64_t* outMask) {
+    for (std::size_t w = 0; w < (count + 63) / 64; ++w) outMask[w] = 0;
+}
+
+void scalarRange(const Car::OBB& car, const Car::AABB& box,
+                 const float* minX, const float* maxX,
+                 const float* minZ, const float* maxZ,
+                 std::size_t begin, std::size_t end, std::uint64_t* outMask) {
+    for (std::size_t i = begin; i < end; ++i) {
+        if (enclosingOverlaps(box, minX[i], maxX[i], minZ[i], maxZ[i]) &&
+            carAxesOverlap(car, minX[i], maxX[i], minZ[i], maxZ[i])) {
+            outMask[i >> 6] |= std::uint64_t{1} << (i & 63);
+        }
+    }
+}
+
+}
+
+bool obbOverlaps(const Car::OBB& car, const GameObject::AABB& box, ObbContact* contact) {
+    const Car::AABB outer = car.enclosing();
+    if (!enclosingOverlaps(outer, box.minX, box.maxX, box.minZ, box.maxZ)) return false;
+    if (!car.axisAligned() && !carAxesOverlap(car, box.minX, box.maxX, box.minZ, box.maxZ)) return false;
+    if (!contact) return true;
+
+    // smallest overlap over the four axes; pushes point away from the box
+    const float ex = (box.maxX - box.minX) * 0.5f;
+    const float ez = (box.maxZ - box.minZ) * 0.5f;
+    const float dx = car.x - (box.minX + box.maxX) * 0.5f;
+    const float dz = car.z - (box.minZ + box.maxZ) * 0.5f;
+    const float ax = std::abs(car.forwardX);
+    const float az = std::abs(car.forwardZ);
+
+    struct Axis { float x, z, overlap, distance; };
+    const float along = dx * car.forwardX + dz * car.forwardZ;
+    const float across = dx * car.forwardZ - dz * car.forwardX;
+    const Axis axes[4] = {
+        {1.f, 0.f, car.extentX() + ex - std::abs(dx), dx},
+        {0.f, 1.f, car.extentZ() + ez - std::abs(dz), dz},
+        {car.forwardX, car.forwardZ, car.halfL + ex * ax + ez * az - std::abs(along), along},
+        {car.forwardZ, -car.forwardX, car.halfW + ex * az + ez * ax - std::abs(across), across},
+    };
+
+    // an axis-aligned car only has the two world axes
+    const int axisCount = car.axisAligned() ? 2 : 4;
+    int best = 0;
+    for (int a = 1; a < axisCount; ++a) {
+        if (axes[a].overlap < axes[best].overlap) best = a;
+    }
+
+    const float sign = axes[best].distance < 0.f ? -1.f : 1.f;
+    contact->normalX = axes[best].x * sign;
+    contact->normalZ = axes[best].z * sign;
+    contact->depth = std::max(0.f, axes[best].overlap);
+    return true;
+}
+
+void obbOverlapMaskScalar(const Car::OBB& car,
+                          const float* minX, const float* maxX,
+                          const float* minZ, const float* maxZ,
+                          std::size_t count, std::uint64_t* outMask) {
+    if (car.axisAligned()) {
+        aabbOverlapMaskScalar(car.enclosing(), minX, maxX, minZ, maxZ, count, outMask);
+        return;
+    }
+    clearMask(count, outMask);
+    scalarRange(car, car.enclosing(), minX, maxX, minZ, maxZ, 0, count, outMask);
+}
+
+void obbOverlapMask(const Car::OBB& car,
+                    const float* minX, const float* maxX,
+                    const float* minZ, const float* maxZ,
+                    std::size_t count, std::uint64_t* outMask) {
+    const Car::AABB box = car.enclosing();
+    if (car.axisAligned()) {
+        aabbOverlapMask(box, minX, maxX, minZ, maxZ, count, outMask);
+        return;
+    }
+    clearMask(count, outMask);
+    std::size_t i = 0;
+
+#if defined(BILSIM_KERNEL_AVX2)
+    const __m256 cMinX = _mm256_set1_ps(box.minX);
+    const __m256 cMaxX = _mm256_set1_ps(box.maxX);
+    const __m256 cMinZ = _mm256_set1_ps(box.minZ);
+    const __m256 cMaxZ = _mm256_set1_ps(box.maxZ);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 cx = _mm256_set1_ps(car.x);
+    const __m256 cz = _mm256_set1_ps(car.z);
+    const __m256 fx = _mm256_set1_ps(car.forwardX);
+    const __m256 fz = _mm256_set1_ps(car.forwardZ);
+    const __m256 ax = _mm256_set1_ps(std::abs(car.forwardX));
+    const __m256 az = _mm256_set1_ps(std::abs(car.forwardZ));
+    const __m256 hw = _mm256_set1_ps(car.halfW);
+    const __m256 hl = _mm256_set1_ps(car.halfL);
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256 lx = _mm256_loadu_ps(minX + i), hx = _mm256_loadu_ps(maxX + i);
+        const __m256 lz = _mm256_loadu_ps(minZ + i), hz = _mm256_loadu_ps(maxZ + i);
+
+        __m256 hit = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(cMinX, hx, _CMP_LE_OQ), _mm256_cmp_ps(cMaxX, lx, _CMP_GE_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(cMinZ, hz, _CMP_LE_OQ), _mm256_cmp_ps(cMaxZ, lz, _CMP_GE_OQ)));
+        if (_mm256_movemask_ps(hit) == 0) continue;
+
+        const __m256 ex = _mm256_mul_ps(_mm256_sub_ps(hx, lx), half);
+        const __m256 ez = _mm256_mul_ps(_mm256_sub_ps(hz, lz), half);
+        const __m256 dx = _mm256_sub_ps(cx, _mm256_mul_ps(_mm256_add_ps(lx, hx), half));
+        const __m256 dz = _mm256_sub_ps(cz, _mm256_mul_ps(_mm256_add_ps(lz, hz), half));
+
+        const __m256 along = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(dx, fx), _mm256_mul_ps(dz, fz)), absMask);
+        const __m256 across = _mm256_and_ps(_mm256_sub_ps(_mm256_mul_ps(dx, fz), _mm256_mul_ps(dz, fx)), absMask);
+        const __m256 reachL = _mm256_add_ps(hl, _mm256_add_ps(_mm256_mul_ps(ex, ax), _mm256_mul_ps(ez, az)));
+        const __m256 reachW = _mm256_add_ps(hw, _mm256_add_ps(_mm256_mul_ps(ex, az), _mm256_mul_ps(ez, ax)));
+
+        hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(along, reachL, _CMP_LE_OQ),
+                                               _mm256_cmp_ps(across, reachW, _CMP_LE_OQ)));
+        auto bits = static_cast<std::uint64_t>(_mm256_movemask_ps(hit));
+        outMask[i >> 6] |= bits << (i & 63);
+    }
+#elif defined(BILSIM_KERNEL_SSE2)
+    const __m128 cMinX = _mm_set1_ps(box.minX);
+    const __m128 cMaxX = _mm_set1_ps(box.maxX);
+    const __m128 cMinZ = _mm_set1_ps(box.minZ);
+    const __m128 cMaxZ = _mm_set1_ps(box.maxZ);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 cx = _mm_set1_ps(car.x);
+    const __m128 cz = _mm_set1_ps(car.z);
+    const __m128 fx = _mm_set1_ps(car.forwardX);
+    const __m128 fz = _mm_set1_ps(car.forwardZ);
+    const __m128 ax = _mm_set1_ps(std::abs(car.forwardX));
+    const __m128 az = _mm_set1_ps(std::abs(car.forwardZ));
+    const __m128 hw = _mm_set1_ps(car.halfW);
+    const __m128 hl = _mm_set1_ps(car.halfL);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 lx = _mm_loadu_ps(minX + i), hx = _mm_loadu_ps(maxX + i);
+        const __m128 lz = _mm_loadu_ps(minZ + i), hz = _mm_loadu_ps(maxZ + i);
+
+        __m128 hit = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(cMinX, hx), _mm_cmpge_ps(cMaxX, lx)),
+                                _mm_and_ps(_mm_cmple_ps(cMinZ, hz), _mm_cmpge_ps(cMaxZ, lz)));
+        if (_mm_movemask_ps(hit) == 0) continue;
+
+        const __m128 ex = _mm_mul_ps(_mm_sub_ps(hx, lx), half);
+        const __m128 ez = _mm_mul_ps(_mm_sub_ps(hz, lz), half);
+        const __m128 dx = _mm_sub_ps(cx, _mm_mul_ps(_mm_add_ps(lx, hx), half));
+        const __m128 dz = _mm_sub_ps(cz, _mm_mul_ps(_mm_add_ps(lz, hz), half));
+
+        const __m128 along = _mm_and_ps(_mm_add_ps(_mm_mul_ps(dx, fx), _mm_mul_ps(dz, fz)), absMask);
+        const __m128 across = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(dx, fz), _mm_mul_ps(dz, fx)), absMask);
+        const __m128 reachL = _mm_add_ps(hl, _mm_add_ps(_mm_mul_ps(ex, ax), _mm_mul_ps(ez, az)));
+        const __m128 reachW = _mm_add_ps(hw, _mm_add_ps(_mm_mul_ps(ex, az), _mm_mul_ps(ez, ax)));
+
+        hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(along, reachL), _mm_cmple_ps(across, reachW)));
+        auto bits = static_cast<std::uint64_t>(_mm_movemask_ps(hit));
+        outMask[i >> 6] |= bits << (i & 63);
+    }
+#endif
+
+    // tail (and the whole range on non-x86 targets)
+    scalarRange(car, box, minX, maxX, minZ, maxZ, i, count, outMask);
+}
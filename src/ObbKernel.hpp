@@ -0,0 +1,39 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_OBBKERNEL_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_OBBKERNEL_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Car.hpp"
+#include "GameObject.hpp"
+
+// Rotated car box vs collider boxes: separating axis test on the two world
+// axes and the car's forward and side axes. Touching counts as overlap,
+// like World::intersects.
+
+// Minimum translation that separates the car from the box: move the car by
+// (normalX, normalZ) * depth
+struct ObbContact {
+    float normalX = 0.f;
+    float normalZ = 0.f;
+    float depth = 0.f;
+};
+
+bool obbOverlaps(const Car::OBB& car, const GameObject::AABB& box, ObbContact* contact = nullptr);
+
+// Batched form, same mask layout as aabbOverlapMask (AabbKernel.hpp).
+// A group of boxes is first tested against car.enclosing(); the two car
+// axes are only computed for groups that have a hit. An axis-aligned car
+// is just its enclosing box and goes straight to aabbOverlapMask.
+void obbOverlapMask(const Car::OBB& car,
+                    const float* minX, const float* maxX,
+                    const float* minZ, const float* maxZ,
+                    std::size_t count, std::uint64_t* outMask);
+
+void obbOverlapMaskScalar(const Car::OBB& car,
+                          const float* minX, const float* maxX,
+                          const float* minZ, const float* maxZ,
+                          std::size_t count, std::uint64_t* outMask);
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_OBBKERNEL_HPP
@@ -0,0 +1,30 @@
+#include "ObjectArena.hpp"
+
+ObjectArena& ObjectArena::operator=(ObjectArena&& other) noexcept {
+    if (this == &other) return *this;
+    rewind();
+    block_ = std::move(other.block_);
+    blocks_ = std::exchange(other.blocks_, 0);
+    used_ = std::exchange(other.used_, 0);
+    count_ = std::exchange(other.count_, 0);
+    return *this;
+}
+
+void ObjectArena::reserve(std::size_t bytes) {
+    rewind();
+    if (bytes <= capacity()) return;
+
+    blocks_ = (bytes + sizeof(Block) - 1) / sizeof(Block);
+    block_.reset(new Block[blocks_]); // left uninitialised
+}
+
+void ObjectArena::rewind() {
+    std::size_t offset = 0;
+    while (offset < used_) {
+        auto* header = std::launder(reinterpret_cast<Header*>(data() + offset));
+        header->destroy(data() + offset + sizeof(Header));
+        offset += header->size;
+    }
+    used_ = 0;
+    count_ = 0;
+}
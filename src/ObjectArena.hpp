@@ -0,0 +1,88 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_OBJECTARENA_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_OBJECTARENA_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Monotonic arena: objects of any type are constructed one after another in
+// a single block, in creation order, and all destroyed together by rewind().
+// The block is kept, so filling the arena again with the same objects does
+// not touch the heap.
+//
+// There is no growing: reserve() the bytes up front (footprint<T>() per
+// object), create() returns nullptr when the block is full. Objects never
+// move, so pointers to them stay valid until rewind(), also when the arena
+// itself is moved.
+class ObjectArena {
+public:
+    static constexpr std::size_t Alignment = alignof(std::max_align_t);
+
+    ObjectArena() = default;
+    ~ObjectArena() { rewind(); }
+
+    ObjectArena(const ObjectArena&) = delete;
+    ObjectArena& operator=(const ObjectArena&) = delete;
+    ObjectArena(ObjectArena&& other) noexcept { *this = std::move(other); }
+    ObjectArena& operator=(ObjectArena&& other) noexcept;
+
+    // Bytes one T takes in the arena (object + destructor record)
+    template <typename T>
+    static constexpr std::size_t footprint() {
+        return sizeof(Header) + roundUp(sizeof(T));
+    }
+
+    // Rewinds, then makes room for at least bytes; a block that is big
+    // enough is reused
+    void reserve(std::size_t bytes);
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(alignof(T) <= Alignment, "over-aligned types are not supported");
+        if (capacity() - used_ < footprint<T>()) return nullptr;
+
+        std::byte* at = data() + used_;
+        T* object = ::new (at + sizeof(Header)) T(std::forward<Args>(args)...);
+        ::new (at) Header{&destroy<T>, footprint<T>()};
+        used_ += footprint<T>();
+        count_++;
+        return object;
+    }
+
+    // Destroys the objects in creation order and starts over at the front
+    void rewind();
+
+    std::size_t size() const { return count_; }
+    std::size_t used() const { return used_; }
+    std::size_t capacity() const { return blocks_ * sizeof(Block); }
+
+private:
+    using Block = std::max_align_t;
+
+    // in front of every object: how to destroy it and where the next one starts
+    struct alignas(Alignment) Header {
+        void (*destroy)(void*);
+        std::size_t size;
+    };
+
+    std::unique_ptr<Block[]> block_;
+    std::size_t blocks_ = 0;
+    std::size_t used_ = 0;   // bytes
+    std::size_t count_ = 0;
+
+    std::byte* data() { return reinterpret_cast<std::byte*>(block_.get()); }
+
+    static constexpr std::size_t roundUp(std::size_t bytes) {
+        return (bytes + Alignment - 1) / Alignment * Alignment;
+    }
+
+    template <typename T>
+    static void destroy(void* object) {
+        static_cast<T*>(object)->~T();
+    }
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_OBJECTARENA_HPP
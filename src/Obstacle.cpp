@@ -1,4 +1,5 @@
 #include "Obstacle.hpp"
+#include "ObbKernel.hpp"
 #include <cmath>
 #include <algorithm> // REQUIRED for std::min/std::max
 
@@ -7,8 +8,29 @@ Obstacle::Obstacle(float x, float z, float halfW, float halfL) {
 }
 
 void Obstacle::onCarOverlap(Car& car) {
-    auto cb = car.bounds();
-    auto ob = bounds_;
+    resolve(bounds_, car);
+}
+
+void Obstacle::resolve(const AABB& box, Car& car) {
+    const Car::OBB obb = car.orientedBounds();
+    if (!obb.axisAligned()) {
+        // rotated car: out along the separating axis with the least overlap
+        ObbContact contact;
+        if (obbOverlaps(obb, box, &contact)) {
+            car.setPosition(obb.x + contact.normalX * contact.depth, obb.z + contact.normalZ * contact.depth);
+        }
+        return;
+    }
+
+    float px = car.position().x;
+    float pz = car.position().z;
+    resolve(box, px, pz, car.getHalfWidth(), car.getHalfLength());
+    car.setPosition(px, pz);
+}
+
+void Obstacle::resolve(const AABB& box, float& x, float& z, float halfW, float halfL) {
+    const AABB cb{x - halfW, x + halfW, z - halfL, z + halfL};
+    const AABB& ob = box;
 
     // Compute overlap on each axis
     float overlapX1 = ob.maxX - cb.minX;
@@ -20,25 +42,20 @@ void Obstacle::onCarOverlap(Car& car) {
     float overlapZ = std::min(overlapZ1, overlapZ2);
 
     // Move along the smallest overlap axis
-    float px = car.position().x;
-    float pz = car.position().z;
-
     if (overlapX < overlapZ) {
         // Resolve X axis collision
         if (overlapX1 < overlapX2) {
-            px = ob.maxX + car.getHalfWidth();   // push right
+            x = ob.maxX + halfW;   // push right
         } else {
-            px = ob.minX - car.getHalfWidth();   // push left
+            x = ob.minX - halfW;   // push left
         }
-        car.setPosition(px, pz);
     } else {
         // Resolve Z axis collision
         if (overlapZ1 < overlapZ2) {
-            pz = ob.maxZ + car.getHalfLength();  // push forward
+            z = ob.maxZ + halfL;  // push forward
         } else {
-            pz = ob.minZ - car.getHalfLength();  // push backward
+            z = ob.minZ - halfL;  // push backward
         }
-        car.setPosition(px, pz);
     }
 
     // Optional: slow car when hitting a wall
@@ -9,6 +9,13 @@ class Obstacle : public GameObject {
 public:
     Obstacle(float x, float z, float halfW, float halfL);
     void onCarOverlap(Car& car) override;
+
+    // Pushes the car out of box along the axis of least overlap (for a
+    // rotated car one of its own axes can be that axis)
+    static void resolve(const AABB& box, Car& car);
+
+    // Same for a car given as centre + half extents (used by the fleet)
+    static void resolve(const AABB& box, float& x, float& z, float halfW, float halfL);
 };
 
 
@@ -9,9 +9,14 @@ Pickup::Pickup(Type type, float x, float z)
 }
 
 void Pickup::onCarOverlap(Car& car) {
-    if (!active_) return;
+    if (!isActive()) return;
 
-    switch (type_) {
+    applyEffect(type_, car);
+    deactivate();
+}
+
+void Pickup::applyEffect(Type type, Car& car) {
+    switch (type) {
 
         case Type::SpeedBoost:
             car.applySpeedBoost();
@@ -21,6 +26,4 @@ void Pickup::onCarOverlap(Car& car) {
             car.applySizeChange();
             break;
     }
-
-    active_ = false;
 }
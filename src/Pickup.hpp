@@ -11,6 +11,11 @@ public:
     Pickup(Type type, float x, float z);
     void onCarOverlap(Car& car) override;
 
+    Type type() const { return type_; }
+
+    // The effect a pickup of this type has on the car
+    static void applyEffect(Type type, Car& car);
+
 private:
     Type type_;
 };
@@ -0,0 +1,161 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Event {
+    const char* name;
+    std::uint64_t startNs;
+    std::uint64_t endNs;
+};
+
+// Single writer (the owning thread). head is published with release, so a
+// reader that loads it with acquire sees every event before it. Events the
+// writer overwrites while a dump is reading them may come out torn; the
+// dump is for humans, so that is accepted instead of a lock on every scope.
+struct Ring {
+    std::unique_ptr<Event[]> events{new Event[Profiler::RingSize]};
+    std::atomic<std::uint64_t> head{0};
+    std::atomic<std::uint64_t> floor{0};   // set by clear(): older events are ignored
+    std::uint32_t threadId = 0;
+    std::string threadName;                // guarded by Registry::mutex
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Ring>> rings; // never shrinks, rings outlive their threads
+    std::atomic<bool> enabled{true};
+    const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+Ring& threadRing() {
+    thread_local Ring* ring = [] {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        auto r = std::make_unique<Ring>();
+        r->threadId = static_cast<std::uint32_t>(reg.rings.size() + 1);
+        r->threadName = "thread " + std::to_string(r->threadId);
+        reg.rings.push_back(std::move(r));
+        return reg.rings.back().get();
+    }();
+    return *ring;
+}
+
+// Chrome wants microseconds; keep the nanoseconds as decimals
+void writeMicros(std::ofstream& out, std::uint64_t ns) {
+    out << ns / 1000 << '.' << static_cast<char>('0' + ns / 100 % 10)
+        << static_cast<char>('0' + ns / 10 % 10) << static_cast<char>('0' + ns % 10);
+}
+
+void writeEscaped(std::ofstream& out, const std::string& s) {
+    for (char c : s) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+}
+
+}
+
+std::uint64_t Profiler::nowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - registry().origin).count());
+}
+
+void Profiler::record(const char* name, std::uint64_t startNs, std::uint64_t endNs) {
+    if (!registry().enabled.load(std::memory_order_relaxed)) return;
+
+    Ring& ring = threadRing();
+    const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+    ring.events[head & (RingSize - 1)] = {name, startNs, endNs};
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::setEnabled(bool enabled) {
+    registry().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::enabled() {
+    return registry().enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    Ring& ring = threadRing();
+    std::lock_guard lock(registry().mutex);
+    ring.threadName = name;
+}
+
+std::size_t Profiler::eventCount() {
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    std::size_t count = 0;
+    for (const auto& ring : reg.rings) {
+        const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+        const std::uint64_t floor = ring->floor.load(std::memory_order_relaxed);
+        const std::uint64_t available = head - std::min(head, floor);
+        count += static_cast<std::size_t>(std::min<std::uint64_t>(available, RingSize));
+    }
+    return count;
+}
+
+void Profiler::clear() {
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    for (auto& ring : reg.rings) {
+        ring->floor.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&] {
+        if (!first) out << ",\n";
+        first = false;
+    };
+
+    for (const auto& ring : reg.rings) {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadId
+            << ",\"args\":{\"name\":\"";
+        writeEscaped(out, ring->threadName);
+        out << "\"}}";
+
+        const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+        std::uint64_t begin = ring->floor.load(std::memory_order_relaxed);
+        if (head - std::min(head, begin) > RingSize) begin = head - RingSize;
+
+        for (std::uint64_t i = begin; i < head; ++i) {
+            const Event e = ring->events[i & (RingSize - 1)];
+            separator();
+            out << "{\"name\":\"";
+            writeEscaped(out, e.name);
+            out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->threadId << ",\"ts\":";
+            writeMicros(out, e.startNs);
+            out << ",\"dur\":";
+            writeMicros(out, e.endNs - std::min(e.endNs, e.startNs));
+            out << "}";
+        }
+    }
+
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
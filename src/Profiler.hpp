@@ -0,0 +1,76 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_PROFILER_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_PROFILER_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Scoped timers for finding where a frame goes.
+//
+//   BILSIM_PROFILE_SCOPE("World::update");
+//
+// times the rest of the enclosing block. Every thread writes into its own
+// fixed ring buffer (the newest RingSize scopes are kept) with no locks;
+// writeChromeTrace() dumps all threads as Chrome trace JSON (open it in
+// chrome://tracing or ui.perfetto.dev).
+//
+// The macro only expands to something when built with BILSIM_PROFILING
+// (CMake option of the same name); otherwise it is empty and costs nothing.
+
+class Profiler {
+public:
+    static constexpr std::size_t RingSize = std::size_t{1} << 16;
+
+    // true if the BILSIM_PROFILE_SCOPE macros are compiled in
+    static constexpr bool compiledIn() {
+#if defined(BILSIM_PROFILING)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static std::uint64_t nowNs();
+
+    // name must outlive the profiler (string literals)
+    static void record(const char* name, std::uint64_t startNs, std::uint64_t endNs);
+
+    static void setEnabled(bool enabled);
+    static bool enabled();
+
+    // shown as the thread's name in the trace
+    static void setThreadName(const std::string& name);
+
+    // Scopes currently held in the rings of all threads
+    static std::size_t eventCount();
+
+    // Forget everything recorded so far (threads keep recording)
+    static void clear();
+
+    static bool writeChromeTrace(const std::string& path);
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name_(name), start_(Profiler::nowNs()) {}
+    ~ProfileScope() { Profiler::record(name_, start_, Profiler::nowNs()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    std::uint64_t start_;
+};
+
+#define BILSIM_PROFILE_CONCAT_INNER(a, b) a##b
+#define BILSIM_PROFILE_CONCAT(a, b) BILSIM_PROFILE_CONCAT_INNER(a, b)
+
+#if defined(BILSIM_PROFILING)
+#define BILSIM_PROFILE_SCOPE(name) ProfileScope BILSIM_PROFILE_CONCAT(bilsimProfileScope_, __LINE__)(name)
+#else
+#define BILSIM_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_PROFILER_HPP
@@ -0,0 +1,116 @@
+#include "RayKernel.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BILSIM_KERNEL_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BILSIM_KERNEL_SSE2 1
+#endif
+
+namespace {
+
+// min/max as minps/maxps compute them, so every path agrees bit for bit
+inline float vmin(float a, float b) { return a < b ? a : b; }
+inline float vmax(float a, float b) { return a > b ? a : b; }
+
+// instead of infinity: (bound - origin) * inv stays free of 0 * inf = NaN
+inline float inverse(float d) {
+    return std::abs(d) > 1e-20f ? 1.f / d : 1e30f;
+}
+
+std::uint64_t scalarRange(const RayFan& rays, const GameObject::AABB& box, float* tEnter,
+                          std::size_t begin, std::size_t end) {
+    std::uint64_t mask = 0;
+    for (std::size_t k = begin; k < end; ++k) {
+        const float x1 = (box.minX - rays.originX) * rays.invDirX[k];
+        const float x2 = (box.maxX - rays.originX) * rays.invDirX[k];
+        const float z1 = (box.minZ - rays.originZ) * rays.invDirZ[k];
+        const float z2 = (box.maxZ - rays.originZ) * rays.invDirZ[k];
+
+        const float enter = vmax(vmax(vmin(x1, x2), vmin(z1, z2)), 0.f);
+        const float exit = vmin(vmax(x1, x2), vmax(z1, z2));
+        tEnter[k] = enter;
+        if (enter <= exit && enter < rays.t[k]) mask |= std::uint64_t{1} << k;
+    }
+    return mask;
+}
+
+}
+
+void RayFan::set(float x, float z, float heading, float fov, std::size_t rays, float range) {
+    originX = x;
+    originZ = z;
+    count = std::min(rays, MaxRays);
+
+    // a full circle would put the last ray on top of the first
+    const bool circle = fov >= 6.2831853f;
+    const float step = count > 1 ? fov / float(circle ? count : count - 1) : 0.f;
+    const float first = circle || count == 1 ? heading : heading + fov * 0.5f;
+
+    for (std::size_t k = 0; k < count; ++k) {
+        const float angle = first - step * float(k);
+        dirX[k] = std::sin(angle);
+        dirZ[k] = std::cos(angle);
+        invDirX[k] = inverse(dirX[k]);
+        invDirZ[k] = inverse(dirZ[k]);
+        t[k] = range;
+    }
+}
+
+std::uint64_t raySlabMaskScalar(const RayFan& rays, const GameObject::AABB& box, float* tEnter) {
+    return scalarRange(rays, box, tEnter, 0, rays.count);
+}
+
+std::uint64_t raySlabMask(const RayFan& rays, const GameObject::AABB& box, float* tEnter) {
+    std::uint64_t mask = 0;
+    std::size_t k = 0;
+
+#if defined(BILSIM_KERNEL_AVX2)
+    const __m256 minX = _mm256_set1_ps(box.minX - rays.originX);
+    const __m256 maxX = _mm256_set1_ps(box.maxX - rays.originX);
+    const __m256 minZ = _mm256_set1_ps(box.minZ - rays.originZ);
+    const __m256 maxZ = _mm256_set1_ps(box.maxZ - rays.originZ);
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (; k + 8 <= rays.count; k += 8) {
+        const __m256 ix = _mm256_load_ps(rays.invDirX + k);
+        const __m256 iz = _mm256_load_ps(rays.invDirZ + k);
+        const __m256 x1 = _mm256_mul_ps(minX, ix), x2 = _mm256_mul_ps(maxX, ix);
+        const __m256 z1 = _mm256_mul_ps(minZ, iz), z2 = _mm256_mul_ps(maxZ, iz);
+
+        const __m256 enter = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(x1, x2), _mm256_min_ps(z1, z2)), zero);
+        const __m256 exit = _mm256_min_ps(_mm256_max_ps(x1, x2), _mm256_max_ps(z1, z2));
+        _mm256_storeu_ps(tEnter + k, enter);
+
+        const __m256 hit = _mm256_and_ps(_mm256_cmp_ps(enter, exit, _CMP_LE_OQ),
+                                         _mm256_cmp_ps(enter, _mm256_load_ps(rays.t + k), _CMP_LT_OQ));
+        mask |= static_cast<std::uint64_t>(_mm256_movemask_ps(hit)) << k;
+    }
+#elif defined(BILSIM_KERNEL_SSE2)
+    const __m128 minX = _mm_set1_ps(box.minX - rays.originX);
+    const __m128 maxX = _mm_set1_ps(box.maxX - rays.originX);
+    const __m128 minZ = _mm_set1_ps(box.minZ - rays.originZ);
+    const __m128 maxZ = _mm_set1_ps(box.maxZ - rays.originZ);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; k + 4 <= rays.count; k += 4) {
+        const __m128 ix = _mm_load_ps(rays.invDirX + k);
+        const __m128 iz = _mm_load_ps(rays.invDirZ + k);
+        const __m128 x1 = _mm_mul_ps(minX, ix), x2 = _mm_mul_ps(maxX, ix);
+        const __m128 z1 = _mm_mul_ps(minZ, iz), z2 = _mm_mul_ps(maxZ, iz);
+
+        const __m128 enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(x1, x2), _mm_min_ps(z1, z2)), zero);
+        const __m128 exit = _mm_min_ps(_mm_max_ps(x1, x2), _mm_max_ps(z1, z2));
+        _mm_storeu_ps(tEnter + k, enter);
+
+        const __m128 hit = _mm_and_ps(_mm_cmple_ps(enter, exit), _mm_cmplt_ps(enter, _mm_load_ps(rays.t + k)));
+        mask |= static_cast<std::uint64_t>(_mm_movemask_ps(hit)) << k;
+    }
+#endif
+
+    // tail (and the whole fan on non-x86 targets)
+    return mask | scalarRange(rays, box, tEnter, k, rays.count);
+}
@@ -0,0 +1,43 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_RAYKERNEL_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_RAYKERNEL_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "GameObject.hpp"
+
+// Up to 64 rays from one point (a car's lidar), structure-of-arrays.
+// t[k] is how far ray k still looks: its range at first, then the nearest
+// hit found so far.
+struct RayFan {
+    static constexpr std::size_t MaxRays = 64;
+
+    float originX = 0.f;
+    float originZ = 0.f;
+    std::size_t count = 0;
+    alignas(32) float dirX[MaxRays];
+    alignas(32) float dirZ[MaxRays];
+    alignas(32) float invDirX[MaxRays];   // finite even for axis-parallel rays (see set())
+    alignas(32) float invDirZ[MaxRays];
+    alignas(32) float t[MaxRays];
+
+    // count rays spread evenly over fov radians, centred on heading (ray 0
+    // at the left edge, or straight ahead for a full circle); same angle
+    // convention as Car::rotation(): direction = (sin, cos)
+    void set(float x, float z, float heading, float fov, std::size_t rays, float range);
+};
+
+// Slab test of every ray in the fan against one box.
+//
+// Bit k of the result is set when ray k enters the box at a distance in
+// [0, t[k]) (a ray starting inside enters at 0); tEnter[k] is then that
+// distance. Other tEnter entries are unspecified. t is not changed.
+//
+// raySlabMask tests 8 rays per step with AVX2 (BILSIM_AVX2 build), 4 with
+// SSE2, and falls back to raySlabMaskScalar elsewhere. All paths give the
+// same masks and distances (same operations in the same order).
+std::uint64_t raySlabMask(const RayFan& rays, const GameObject::AABB& box, float* tEnter);
+std::uint64_t raySlabMaskScalar(const RayFan& rays, const GameObject::AABB& box, float* tEnter);
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_RAYKERNEL_HPP
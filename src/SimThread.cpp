@@ -0,0 +1,119 @@
+#include "SimThread.hpp"
+#include "FixedTimestep.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+
+using Clock = std::chrono::steady_clock;
+
+SimThread::SimThread(Game& game, double stepSeconds, InputRecording* recording)
+    : game_(game), step_(stepSeconds), recording_(recording) {
+    // a frame to read before the first tick
+    car_ = prevCar_ = SimCarState::from(game_.world().car());
+    carVersion_ = game_.world().car().version();
+    publish(true);
+    frames_.fetch();
+}
+
+SimThread::~SimThread() {
+    stop();
+}
+
+void SimThread::start() {
+    if (running()) return;
+    stop_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread([this] { run(); });
+}
+
+void SimThread::stop() {
+    if (!running()) return;
+    stop_.store(true, std::memory_order_release);
+    thread_.join();
+}
+
+float SimThread::alpha(Clock::time_point now) const {
+    const double since = std::chrono::duration<double>(now - frame().time).count();
+    return static_cast<float>(std::clamp(since / step_, 0.0, 1.0));
+}
+
+void SimThread::run() {
+    Profiler::setThreadName("simulation");
+
+    FixedTimestep timestep(step_, 8);
+    auto last = Clock::now();
+    const float dt = timestep.step();
+
+    while (!stop_.load(std::memory_order_acquire)) {
+        World& world = game_.world();
+        bool changed = false;
+
+        SimCommand command;
+        while (commands_.pop(command)) {
+            switch (command.type) {
+                case SimCommand::Type::Input:
+                    input_ = command.input;
+                    break;
+                case SimCommand::Type::Reset:
+                    game_.reset();
+                    if (recording_) recording_->markReset();
+                    // teleported: nothing to interpolate from
+                    car_ = prevCar_ = SimCarState::from(world.car());
+                    carVersion_ = world.car().version();
+                    resets_++;
+                    changed = true;
+                    break;
+            }
+        }
+
+        const auto now = Clock::now();
+        const int steps = timestep.advance(std::chrono::duration<double>(now - last).count());
+        last = now;
+
+        for (int s = 0; s < steps; ++s) {
+            BILSIM_PROFILE_SCOPE("simulation step");
+
+            prevCar_ = car_;
+
+            // the world stands still once the portal is reached (as in bilsim_headless)
+            if (!world.portalTriggered()) {
+                if (recording_) recording_->record(input_);
+                game_.update(dt, input_);
+
+                for (const auto& e : world.events()) {
+                    if (e.type != WorldEvent::Type::CollisionContact) changed = true;
+                }
+            }
+
+            // speed is drawn too (wheel spin), and changes without a version bump
+            if (world.car().version() != carVersion_ || world.car().speed() != car_.speed) {
+                car_ = SimCarState::from(world.car());
+                carVersion_ = world.car().version();
+            }
+            tick_++;
+        }
+
+        if (steps > 0 || changed) publish(changed);
+
+        // until the next step is due
+        std::this_thread::sleep_for(std::chrono::duration<double>(step_ * (1.0 - timestep.alpha())));
+    }
+}
+
+void SimThread::publish(bool changed) {
+    const World& world = game_.world();
+
+    // assigning into the reused slot keeps the vectors' capacity
+    SimFrame& f = frames_.back();
+    f.prevCar = prevCar_;
+    f.car = car_;
+    f.active = world.colliders().activeBits();
+    f.gateOpen.resize(world.gateCount());
+    for (int g = 1; g <= world.gateCount(); ++g) f.gateOpen[g - 1] = world.gateIsOpen(g);
+    f.portalTriggered = world.portalTriggered();
+    f.tick = tick_;
+    f.resets = resets_;
+    if (changed) changes_++;
+    f.changes = changes_;
+    f.time = Clock::now();
+
+    frames_.publish();
+}
@@ -0,0 +1,111 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_SIMTHREAD_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_SIMTHREAD_HPP
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "Game.hpp"
+#include "InputRecording.hpp"
+#include "InputState.hpp"
+#include "SpscQueue.hpp"
+#include "TripleBuffer.hpp"
+
+// What the renderer needs of the car at one tick
+struct SimCarState {
+    float x = 0.f;
+    float z = 0.f;
+    float rotation = 0.f;
+    float scale = 1.f;
+    float speed = 0.f;
+
+    static SimCarState from(const Car& car) {
+        return {car.position().x, car.position().z, car.rotation(), car.getVisualScale(), car.speed()};
+    }
+
+    bool operator==(const SimCarState&) const = default;
+};
+
+// Render-relevant state after a batch of ticks, published as one piece
+struct SimFrame {
+    SimCarState prevCar;                 // before the last tick
+    SimCarState car;                     // after it
+    std::vector<std::uint64_t> active;   // collider active bits: a pickup is visible while its bit is set
+    std::vector<std::uint8_t> gateOpen;  // gateOpen[n - 1] for gate n
+    bool portalTriggered = false;
+
+    std::uint64_t tick = 0;              // ticks run since start()
+    std::uint32_t resets = 0;            // counts resets (the car may have jumped)
+    std::uint32_t changes = 0;           // counts ticks that changed pickups, gates or the portal
+    std::chrono::steady_clock::time_point time; // when the last tick finished
+};
+
+// Input changes and resets, from the input thread to the simulation thread
+struct SimCommand {
+    enum class Type : std::uint8_t { Input, Reset };
+    Type type = Type::Input;
+    InputState input;
+};
+
+// Runs a Game on its own thread in fixed steps, so rendering and physics
+// no longer stall each other.
+//
+// Commands come in through an SPSC queue; after every batch of ticks the
+// state above is published into a triple buffer the render thread reads
+// without locks. The game (and the recording) belong to the simulation
+// thread between start() and stop(); touch them only before or after.
+class SimThread {
+public:
+    SimThread(Game& game, double stepSeconds, InputRecording* recording = nullptr);
+    ~SimThread();
+
+    SimThread(const SimThread&) = delete;
+    SimThread& operator=(const SimThread&) = delete;
+
+    void start();
+    void stop();    // joins; safe to call twice
+    bool running() const { return thread_.joinable(); }
+
+    // Input thread (one thread only). false if the queue is full.
+    bool post(const SimCommand& command) { return commands_.push(command); }
+    bool setInput(const InputState& input) { return post({SimCommand::Type::Input, input}); }
+    bool reset() { return post({SimCommand::Type::Reset, {}}); }
+
+    // Render thread: takes the newest published frame (true if there was one)
+    bool fetch() { return frames_.fetch(); }
+    const SimFrame& frame() const { return frames_.front(); }
+
+    // How far (0..1) 'now' is past frame().time, in steps: where to draw
+    // between frame().prevCar and frame().car
+    float alpha(std::chrono::steady_clock::time_point now) const;
+
+    float step() const { return static_cast<float>(step_); }
+
+private:
+    Game& game_;
+    double step_;
+    InputRecording* recording_;
+
+    SpscQueue<SimCommand, 256> commands_;
+    TripleBuffer<SimFrame> frames_;
+
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+
+    // simulation thread only
+    InputState input_;
+    SimCarState prevCar_;
+    SimCarState car_;
+    std::uint32_t carVersion_ = 0;
+    std::uint64_t tick_ = 0;
+    std::uint32_t resets_ = 0;
+    std::uint32_t changes_ = 0;
+
+    void run();
+    void publish(bool changed);
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_SIMTHREAD_HPP
@@ -0,0 +1,49 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_SPSCQUEUE_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_SPSCQUEUE_HPP
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded single-producer / single-consumer queue (lock-free ring).
+// Exactly one thread pushes and one other thread pops; neither ever waits
+// for the other. Capacity must be a power of two.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer. false if the queue is full (the value is not stored).
+    bool push(const T& value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity) return false;
+        slots_[tail & (Capacity - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer. false if the queue is empty.
+    bool pop(T& out) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        out = slots_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // A snapshot: may be out of date as soon as it returns
+    std::size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    // own cache lines, so the two threads don't invalidate each other's index
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::array<T, Capacity> slots_{};
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_SPSCQUEUE_HPP
@@ -0,0 +1,43 @@
+#include "SweptAabb.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Entry/exit time of a centre moving by d through the slab [lo, hi].
+// A centre that does not move is inside for all t or never.
+bool slab(float centre, float d, float lo, float hi, float& enter, float& exit) {
+    if (d == 0.f) {
+        enter = -std::numeric_limits<float>::infinity();
+        exit = std::numeric_limits<float>::infinity();
+        return centre >= lo && centre <= hi;
+    }
+    float t0 = (lo - centre) / d;
+    float t1 = (hi - centre) / d;
+    if (t0 > t1) std::swap(t0, t1);
+    enter = t0;
+    exit = t1;
+    return true;
+}
+
+}
+
+bool sweepAabb(const Car::AABB& moving, float dx, float dz, const GameObject::AABB& target, SweepHit& out) {
+    const float halfW = (moving.maxX - moving.minX) * 0.5f;
+    const float halfL = (moving.maxZ - moving.minZ) * 0.5f;
+    const float cx = moving.minX + halfW;
+    const float cz = moving.minZ + halfL;
+
+    float enterX, exitX, enterZ, exitZ;
+    if (!slab(cx, dx, target.minX - halfW, target.maxX + halfW, enterX, exitX)) return false;
+    if (!slab(cz, dz, target.minZ - halfL, target.maxZ + halfL, enterZ, exitZ)) return false;
+
+    const float enter = std::max(enterX, enterZ);
+    const float exit = std::min(exitX, exitZ);
+    if (enter > exit || enter > 1.f || exit < 0.f) return false;
+
+    out.enter = enter;
+    out.exit = exit;
+    out.axis = enter <= 0.f ? -1 : (enterX >= enterZ ? 0 : 1);
+    return true;
+}
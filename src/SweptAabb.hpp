@@ -0,0 +1,22 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_SWEPTAABB_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_SWEPTAABB_HPP
+#pragma once
+
+#include "Car.hpp"
+#include "GameObject.hpp"
+
+// Time of impact of a moving box against a static one.
+//
+// The moving box keeps its size and travels by (dx, dz) over t = 0..1.
+// Equivalent to a ray from its centre against the target grown by its half
+// extents (slab test). Touching counts as contact, like World::intersects.
+struct SweepHit {
+    float enter = 0.f;   // first contact, <= 0 if the boxes already touch at t = 0
+    float exit = 0.f;    // last contact
+    int axis = -1;       // axis of first contact: 0 = x, 1 = z, -1 = touching at t = 0
+};
+
+// false if the boxes never touch during the move
+bool sweepAabb(const Car::AABB& moving, float dx, float dz, const GameObject::AABB& target, SweepHit& out);
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_SWEPTAABB_HPP
@@ -0,0 +1,149 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace {
+    // which pool/worker the current thread belongs to (if any)
+    thread_local const ThreadPool* tlsPool = nullptr;
+    thread_local unsigned tlsIndex = 0;
+}
+
+ThreadPool::ThreadPool(unsigned threads) {
+    threads = std::max(1u, threads);
+
+    queues_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    threads_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        threads_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard lock(sleepMutex_);
+        stop_ = true;
+    }
+    workAvailable_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+void ThreadPool::submit(Task task) {
+    unsigned index = (tlsPool == this)
+                     ? tlsIndex
+                     : nextQueue_.fetch_add(1, std::memory_order_relaxed) % size();
+
+    pending_.fetch_add(1);
+    {
+        std::lock_guard lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    queued_.fetch_add(1);
+
+    {
+        std::lock_guard lock(sleepMutex_);
+    }
+    workAvailable_.notify_one();
+}
+
+bool ThreadPool::tryPop(unsigned index, Task& out) {
+    auto& q = *queues_[index];
+    std::lock_guard lock(q.mutex);
+    if (q.tasks.empty()) return false;
+
+    out = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    queued_.fetch_sub(1);
+    return true;
+}
+
+bool ThreadPool::trySteal(unsigned thief, Task& out) {
+    const unsigned n = size();
+    for (unsigned k = 1; k <= n; ++k) {
+        unsigned victim = (thief + k) % n;
+        auto& q = *queues_[victim];
+
+        std::lock_guard lock(q.mutex);
+        if (q.tasks.empty()) continue;
+
+        out = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        queued_.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::runTask(Task& task) {
+    task();
+    task = nullptr;
+
+    if (pending_.fetch_sub(1) == 1) {
+        std::lock_guard lock(sleepMutex_);
+        allDone_.notify_all();
+    }
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    tlsPool = this;
+    tlsIndex = index;
+
+    Task task;
+    while (true) {
+        if (tryPop(index, task) || trySteal(index, task)) {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock lock(sleepMutex_);
+        workAvailable_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+        if (stop_ && queued_.load() == 0) return;
+    }
+}
+
+void ThreadPool::wait() {
+    Task task;
+    while (pending_.load() > 0) {
+        if (trySteal(0, task)) {
+            runTask(task);
+            continue;
+        }
+
+        // only running tasks left -> sleep until the last one finishes
+        std::unique_lock lock(sleepMutex_);
+        allDone_.wait(lock, [this] { return pending_.load() == 0; });
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t grain,
+                             const std::function<void(std::size_t, std::size_t)>& fn) {
+    if (count == 0) return;
+    grain = std::max<std::size_t>(1, grain);
+
+    const std::size_t chunks = (count + grain - 1) / grain;
+    std::atomic<std::size_t> remaining{chunks};
+
+    for (std::size_t c = 0; c < chunks; ++c) {
+        const std::size_t begin = c * grain;
+        const std::size_t end = std::min(count, begin + grain);
+        submit([&fn, &remaining, begin, end] {
+            fn(begin, end);
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    // Help with the work until our own chunks are done (this also makes
+    // nested parallelFor calls from inside a worker safe).
+    const unsigned self = (tlsPool == this) ? tlsIndex : 0;
+    Task task;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if ((tlsPool == this && tryPop(self, task)) || trySteal(self, task)) {
+            runTask(task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_THREADPOOL_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_THREADPOOL_HPP
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool.
+// Every worker owns a deque: it pops its own work from the back and steals
+// from the front of the other deques when it runs dry. Tasks submitted from
+// inside a worker go to that worker's own deque.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task task);
+
+    // Blocks until every submitted task has finished.
+    // The calling thread helps out instead of just sleeping.
+    // Must not be called from inside a pool task (use parallelFor there).
+    void wait();
+
+    // Runs fn(begin, end) over [0, count) in chunks of 'grain' and blocks
+    // until all chunks are done.
+    void parallelFor(std::size_t count, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t)>& fn);
+
+    unsigned size() const { return static_cast<unsigned>(threads_.size()); }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::atomic<std::size_t> queued_{0};   // tasks sitting in a deque
+    std::atomic<std::size_t> pending_{0};  // tasks submitted but not finished
+    std::atomic<unsigned> nextQueue_{0};
+    std::atomic<bool> stop_{false};
+
+    std::mutex sleepMutex_;
+    std::condition_variable workAvailable_;
+    std::condition_variable allDone_;
+
+    void workerLoop(unsigned index);
+    bool tryPop(unsigned index, Task& out);
+    bool trySteal(unsigned thief, Task& out);
+    void runTask(Task& task);
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_THREADPOOL_HPP
@@ -0,0 +1,51 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_TRIPLEBUFFER_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_TRIPLEBUFFER_HPP
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// Lock-free triple buffer: one writer publishes complete values, one reader
+// always gets the newest complete one.
+//
+// The writer fills back() and calls publish(), which swaps it with the
+// middle slot. The reader calls fetch(), which swaps the middle slot with
+// front() if something new was published. Neither side ever waits, and the
+// reader never sees a half-written value; values published between two
+// fetches are skipped.
+//
+// The slots are reused, not cleared: the writer must overwrite everything
+// it publishes (for vectors, assigning into the slot keeps its capacity).
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& initial) : slots_{initial, initial, initial} {}
+
+    // Writer
+    T& back() { return slots_[back_]; }
+
+    void publish() {
+        back_ = middle_.exchange(back_ | Fresh, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    // Reader. true if front() changed.
+    bool fetch() {
+        if ((middle_.load(std::memory_order_relaxed) & Fresh) == 0) return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    const T& front() const { return slots_[front_]; }
+
+private:
+    static constexpr unsigned Fresh = 4;     // middle holds a value the reader has not taken
+    static constexpr unsigned IndexMask = 3;
+
+    std::array<T, 3> slots_{};
+    unsigned back_ = 0;                      // writer only
+    alignas(64) std::atomic<unsigned> middle_{1};
+    alignas(64) unsigned front_ = 2;         // reader only
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_TRIPLEBUFFER_HPP
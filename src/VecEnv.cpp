@@ -0,0 +1,162 @@
+#include "VecEnv.hpp"
+#include <algorithm>
+#include <cmath>
+
+VecEnv::VecEnv(const LevelView& level, const Config& config) : config_(config) {
+    config_.batch = std::max<std::size_t>(1, config_.batch);
+    config_.frameSkip = std::max(1u, config_.frameSkip);
+    config_.lidarRays = std::min<std::uint32_t>(config_.lidarRays, RayFan::MaxRays);
+    config_.lidarRange = std::max(config_.lidarRange, 1e-3f);
+    obsSize_ = ObsSize + config_.lidarRays;
+
+    worlds_.reserve(config_.batch);
+    for (std::size_t i = 0; i < config_.batch; ++i) worlds_.emplace_back(level);
+
+    // normalisation from the union of the colliders (the level's extent)
+    const auto& colliders = worlds_[0].colliders();
+    if (!colliders.empty()) {
+        float minX = colliders.minX()[0], maxX = colliders.maxX()[0];
+        float minZ = colliders.minZ()[0], maxZ = colliders.maxZ()[0];
+        for (std::uint32_t i = 1; i < colliders.size(); ++i) {
+            minX = std::min(minX, colliders.minX()[i]);
+            maxX = std::max(maxX, colliders.maxX()[i]);
+            minZ = std::min(minZ, colliders.minZ()[i]);
+            maxZ = std::max(maxZ, colliders.maxZ()[i]);
+        }
+        centerX_ = (minX + maxX) * 0.5f;
+        centerZ_ = (minZ + maxZ) * 0.5f;
+        halfExtentX_ = std::max(1.f, (maxX - minX) * 0.5f);
+        halfExtentZ_ = std::max(1.f, (maxZ - minZ) * 0.5f);
+        diagonal_ = 2.f * std::hypot(halfExtentX_, halfExtentZ_);
+    }
+
+    steps_.assign(batch(), 0);
+    portalDistance_.assign(batch(), 0.f);
+    obs_.assign(batch() * obsSize_, 0.f);
+    rewards_.assign(batch(), 0.f);
+    dones_.assign(batch(), 0);
+
+    const unsigned threads = config_.threads ? config_.threads : std::thread::hardware_concurrency();
+    if (threads > 1 && batch() > 1) pool_ = std::make_unique<ThreadPool>(threads);
+
+    reset();
+}
+
+void VecEnv::reset(std::span<const std::uint8_t> mask) {
+    forEach(&VecEnv::resetRange, mask.size() == batch() ? mask.data() : nullptr);
+}
+
+void VecEnv::step(std::span<const std::uint8_t> actions) {
+    if (actions.size() != batch()) return;
+    forEach(&VecEnv::stepRange, actions.data());
+}
+
+void VecEnv::forEach(void (VecEnv::*fn)(std::size_t, std::size_t, const std::uint8_t*), const std::uint8_t* data) {
+    if (!pool_) {
+        (this->*fn)(0, batch(), data);
+        return;
+    }
+    // a few chunks per thread, so stealing can even out uneven worlds
+    const std::size_t grain = std::max<std::size_t>(1, batch() / (pool_->size() * 4));
+    pool_->parallelFor(batch(), grain, [&](std::size_t begin, std::size_t end) {
+        (this->*fn)(begin, end, data);
+    });
+}
+
+void VecEnv::resetRange(std::size_t begin, std::size_t end, const std::uint8_t* mask) {
+    for (std::size_t i = begin; i < end; ++i) {
+        if (mask && !mask[i]) continue;
+        restart(i);
+        rewards_[i] = 0.f;
+        dones_[i] = 0;
+    }
+}
+
+void VecEnv::stepRange(std::size_t begin, std::size_t end, const std::uint8_t* actions) {
+    for (std::size_t i = begin; i < end; ++i) {
+        World& world = worlds_[i];
+        const InputState in = input(actions[i]);
+
+        float reward = 0.f;
+        bool contact = false;
+        for (unsigned k = 0; k < config_.frameSkip && !world.portalTriggered(); ++k) {
+            world.update(config_.dt, in);
+
+            bool hit = false;
+            for (const auto& e : world.events()) {
+                switch (e.type) {
+                    case WorldEvent::Type::PickupCollected: reward += config_.pickupReward; break;
+                    case WorldEvent::Type::GateOpened:      reward += config_.gateReward; break;
+                    case WorldEvent::Type::PortalEntered:   reward += config_.portalReward; break;
+                    case WorldEvent::Type::CollisionContact: hit = true; break;
+                }
+            }
+            if (hit) reward += config_.contactReward;
+            contact = contact || hit;
+        }
+
+        const float distance = portalDistance(world);
+        reward += (portalDistance_[i] - distance) * config_.progressReward;
+        portalDistance_[i] = distance;
+
+        steps_[i]++;
+        const bool done = world.portalTriggered() || (config_.maxSteps > 0 && steps_[i] >= config_.maxSteps);
+        rewards_[i] = reward;
+        dones_[i] = done ? 1 : 0;
+
+        if (done && config_.autoReset) restart(i);
+        else observe(i, contact);
+    }
+}
+
+void VecEnv::restart(std::size_t i) {
+    worlds_[i].reset();
+    steps_[i] = 0;
+    portalDistance_[i] = portalDistance(worlds_[i]);
+    observe(i, false);
+}
+
+void VecEnv::observe(std::size_t i, bool contact) {
+    const World& world = worlds_[i];
+    const Car& car = world.car();
+    const Car::OBB box = car.orientedBounds();
+    float* o = obs_.data() + i * obsSize_;
+
+    o[PosX] = (car.position().x - centerX_) / halfExtentX_;
+    o[PosZ] = (car.position().z - centerZ_) / halfExtentZ_;
+    o[HeadingSin] = box.forwardX;
+    o[HeadingCos] = box.forwardZ;
+    o[Speed] = car.speed() / 50.f;
+    o[Scale] = car.getVisualScale();
+
+    const int pickups = world.totalPickups();
+    o[PickupsLeft] = pickups > 0 ? float(pickups - world.collectedPickups()) / float(pickups) : 0.f;
+    int open = 0;
+    for (int g = 1; g <= world.gateCount(); ++g) open += world.gateIsOpen(g);
+    o[GatesOpen] = world.gateCount() > 0 ? float(open) / float(world.gateCount()) : 1.f;
+
+    // portal in the car's frame: forward (x, z) = (sin, cos); turning left
+    // increases the rotation, so left = (cos, -sin)
+    const Vec2 portal = world.portalCenter();
+    const float dx = portal.x - car.position().x;
+    const float dz = portal.z - car.position().z;
+    const float distance = std::hypot(dx, dz);
+    const float inv = distance > 1e-6f ? 1.f / distance : 0.f;
+    o[PortalLeft] = (dx * box.forwardZ - dz * box.forwardX) * inv;
+    o[PortalAhead] = (dx * box.forwardX + dz * box.forwardZ) * inv;
+    o[PortalDistance] = distance / diagonal_;
+    o[Contact] = contact ? 1.f : 0.f;
+
+    if (config_.lidarRays == 0) return;
+    RayFan rays;
+    rays.set(car.position().x, car.position().z, car.rotation(),
+             config_.lidarFov, config_.lidarRays, config_.lidarRange);
+    world.castRays(rays);
+    const float invRange = 1.f / config_.lidarRange;
+    for (std::size_t k = 0; k < rays.count; ++k) o[Lidar + k] = rays.t[k] * invRange;
+}
+
+float VecEnv::portalDistance(const World& world) const {
+    const Vec2 portal = world.portalCenter();
+    return std::hypot(portal.x - world.car().position().x, portal.z - world.car().position().z);
+}
@@ -0,0 +1,127 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_VECENV_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_VECENV_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Level.hpp"
+#include "ThreadPool.hpp"
+#include "World.hpp"
+
+// Batched environment for training driving agents: B independent worlds on
+// one level, stepped together and split across the cores.
+//
+// step() takes one action per world and writes observations, rewards and
+// done flags into contiguous buffers allocated once up front (row i is
+// world i). The C API in bilsim_env.h wraps this class.
+class VecEnv {
+public:
+    // Action bits, any combination (0 = coast)
+    enum Action : std::uint8_t {
+        Accelerate = 1,
+        Brake = 2,
+        TurnLeft = 4,
+        TurnRight = 8
+    };
+
+    // Observation row, obsSize() floats per world: the ObsSize values
+    // below, then one lidar distance per ray (Lidar + k)
+    enum Obs : std::size_t {
+        PosX,          // -1..1 over the level's bounds
+        PosZ,
+        HeadingSin,    // car forward vector
+        HeadingCos,
+        Speed,         // / 50 m/s (boosted top speed)
+        Scale,         // visual size (size pickups)
+        PickupsLeft,   // fraction not yet collected
+        GatesOpen,     // fraction open
+        PortalLeft,    // direction to the portal in the car's frame (unit;
+                       // positive left = TurnLeft turns towards it)
+        PortalAhead,
+        PortalDistance,// / level diagonal
+        Contact,       // 1 if the car hit an obstacle during the step
+        ObsSize,
+        Lidar = ObsSize // / lidarRange, 1 = nothing in range
+    };
+
+    struct Config {
+        std::size_t batch = 1;
+        unsigned threads = 0;          // 0 = all cores
+        float dt = 1.f / 60.f;         // per world update
+        unsigned frameSkip = 1;        // world updates per step (action repeat)
+        std::uint32_t maxSteps = 0;    // episode length in steps, 0 = until the portal
+        bool autoReset = true;         // finished worlds restart inside step()
+
+        // rays from the car centre, ray 0 on the left edge of the fan
+        // (straight ahead for a full circle); 0 = no lidar
+        std::uint32_t lidarRays = 0;   // at most RayFan::MaxRays
+        float lidarFov = 6.2831853f;   // radians
+        float lidarRange = 50.f;       // metres
+
+        // reward per event, summed over the updates of a step
+        float pickupReward = 1.f;
+        float gateReward = 1.f;
+        float portalReward = 10.f;
+        float contactReward = -0.1f;   // per update with an obstacle contact
+        float progressReward = 0.01f;  // per metre closer to the portal
+    };
+
+    // The worlds copy the level, it does not have to outlive the env
+    VecEnv(const LevelView& level, const Config& config);
+
+    std::size_t batch() const { return worlds_.size(); }
+    const Config& config() const { return config_; }
+    std::size_t obsSize() const { return obsSize_; }
+
+    // Restarts the worlds whose mask byte is non-zero (all for an empty
+    // mask) and writes their observation rows
+    void reset(std::span<const std::uint8_t> mask = {});
+
+    // One step for every world; actions.size() must be batch(). With
+    // autoReset a finished world reports its final reward and done = 1,
+    // and its observation row already shows the restarted episode.
+    void step(std::span<const std::uint8_t> actions);
+
+    std::span<const float> observations() const { return obs_; }
+    std::span<const float> rewards() const { return rewards_; }
+    std::span<const std::uint8_t> dones() const { return dones_; }
+
+    const World& world(std::size_t i) const { return worlds_[i]; }
+
+    static InputState input(std::uint8_t action) {
+        return {(action & Accelerate) != 0, (action & Brake) != 0,
+                (action & TurnLeft) != 0, (action & TurnRight) != 0};
+    }
+
+private:
+    Config config_;
+    std::size_t obsSize_ = ObsSize;
+    std::vector<World> worlds_;
+    std::vector<std::uint32_t> steps_;    // steps in the current episode
+    std::vector<float> portalDistance_;   // at the end of the last step
+
+    std::vector<float> obs_;
+    std::vector<float> rewards_;
+    std::vector<std::uint8_t> dones_;
+
+    std::unique_ptr<ThreadPool> pool_;    // null when one thread is enough
+
+    // level bounds for the normalisation
+    float centerX_ = 0.f, centerZ_ = 0.f;
+    float halfExtentX_ = 1.f, halfExtentZ_ = 1.f;
+    float diagonal_ = 1.f;
+
+    void forEach(void (VecEnv::*fn)(std::size_t, std::size_t, const std::uint8_t*), const std::uint8_t* data);
+    void resetRange(std::size_t begin, std::size_t end, const std::uint8_t* mask);
+    void stepRange(std::size_t begin, std::size_t end, const std::uint8_t* actions);
+    void restart(std::size_t i);
+    void observe(std::size_t i, bool contact);
+    float portalDistance(const World& world) const;
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_VECENV_HPP
@@ -1,120 +1,247 @@
 #include "World.hpp"
 #include "Pickup.hpp"
 #include "Obstacle.hpp"
+#include "Profiler.hpp"
+#include "SweptAabb.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// For boxes that touch or overlap: does the move (dx, dz) push a further
+// into b? The contact face is on the axis with the smaller overlap (the
+// one Obstacle::resolve would push out along).
+bool movesInto(const Car::AABB& a, float dx, float dz, const GameObject::AABB& b) {
+    const float overlapX = std::min(a.maxX - b.minX, b.maxX - a.minX);
+    const float overlapZ = std::min(a.maxZ - b.minZ, b.maxZ - a.minZ);
+    if (overlapX < overlapZ) {
+        const bool left = a.minX + a.maxX < b.minX + b.maxX;   // car on the -x side
+        return left ? dx > 0.f : dx < 0.f;
+    }
+    const bool below = a.minZ + a.maxZ < b.minZ + b.maxZ;      // car on the -z side
+    return below ? dz > 0.f : dz < 0.f;
+}
 
-World::World() {
-    reset();
 }
 
-void World::reset() {
+World::World() : World(LevelFile::defaultLevel().view()) {}
 
-    car_.reset();
-    car_.setPosition(0.f, 0.f); // start in center
+World::World(const LevelView& level) {
+    load(level);
+}
 
-    objects_.clear();
+void World::load(const LevelView& level) {
+    levelHeader_ = level.header();
+    level_.assign(level.entities().begin(), level.entities().end());
+    levelTriggers_.assign(level.triggers().begin(), level.triggers().end());
+    levelLinks_.assign(level.links().begin(), level.links().end());
+    build();
+}
 
-    // reset gate pointers
-    gate1Obstacle_ = nullptr;
-    gate2Obstacle_ = nullptr;
-    gate3Obstacle_ = nullptr;
+void World::reset() {
+    restore(initial_);
+}
 
-    gate1PickupA_ = gate1PickupB_ = nullptr;
-    gate2PickupA_ = gate2PickupB_ = nullptr;
-    gate3PickupA_ = gate3PickupB_ = nullptr;
+void World::snapshot(WorldSnapshot& out) const {
+    out.car = car_;
+    out.active = colliders_.activeBits();
+    out.gateCollected.resize(gates_.size());
+    for (std::size_t g = 0; g < gates_.size(); ++g) out.gateCollected[g] = gates_[g].collected;
+    fleet_.saveState(out.traffic);
+    out.collectedPickups = collectedPickups_;
+    out.portalTriggered = portalTriggered_;
+}
 
-    portalTriggered_ = false;
+WorldSnapshot World::snapshot() const {
+    WorldSnapshot s;
+    snapshot(s);
+    return s;
+}
 
-    // --------------------------------------------------
-    //  PICKUPS (2 per gate)
-    // --------------------------------------------------
+bool World::restore(const WorldSnapshot& snapshot) {
+    if (snapshot.active.size() != colliders_.activeBits().size() ||
+        snapshot.gateCollected.size() != gates_.size() ||
+        snapshot.traffic.posX.size() != fleet_.size()) {
+        return false;
+    }
 
-    auto addPickup = [&](Pickup::Type t, float x, float z, Pickup*& out) {
-        auto p = std::make_unique<Pickup>(t, x, z);
-        out = p.get();
-        objects_.push_back(std::move(p));
-    };
+    car_.restoreFrom(snapshot.car);
+    colliders_.setActiveBits(snapshot.active);
+    for (std::size_t g = 0; g < gates_.size(); ++g) gates_[g].collected = snapshot.gateCollected[g];
+    fleet_.restoreState(snapshot.traffic);
+    collectedPickups_ = snapshot.collectedPickups;
+    portalTriggered_ = snapshot.portalTriggered;
 
-    // Gate 1 pickups (village)
-    addPickup(Pickup::Type::SpeedBoost, -100.f, -100.f, gate1PickupA_);
-    addPickup(Pickup::Type::SizeChange, -100.f,  -80.f, gate1PickupB_);
+    events_.clear();
+    return true;
+}
 
-    // Gate 2 pickups (castle)
-    addPickup(Pickup::Type::SpeedBoost,   0.f, 90.f, gate2PickupA_);
-    addPickup(Pickup::Type::SizeChange, -10.f, 90.f, gate2PickupB_);
+void World::build() {
 
-    // Gate 3 pickups (smelter)
-    addPickup(Pickup::Type::SpeedBoost,  90.f, -100.f, gate3PickupA_);
-    addPickup(Pickup::Type::SizeChange,  90.f, -110.f, gate3PickupB_);
+    car_.reset();
+    car_.setPosition(levelHeader_.startX, levelHeader_.startZ);
 
-    // --------------------------------------------------
-    //  400x400 WORLD BORDER (ONLY COLLISION WALLS NOW)
-    // --------------------------------------------------
-    const float B = 200.f; // near edge of 400×400 plane
-    const float T = 1.f;   // thickness
+    refs_.clear();
+    colliders_.clear();
+    pickupGate_.clear();
 
-    // north/south
-    objects_.push_back(std::make_unique<Obstacle>(0.f,  B, 200.f, T));
-    objects_.push_back(std::make_unique<Obstacle>(0.f, -B, 200.f, T));
+    gates_.assign(levelHeader_.gateCount, Gate{});
 
-    // west/east
-    objects_.push_back(std::make_unique<Obstacle>(-B, 0.f, T, 200.f));
-    objects_.push_back(std::make_unique<Obstacle>( B, 0.f, T, 200.f));
+    portalX_ = levelHeader_.portalX;
+    portalZ_ = levelHeader_.portalZ;
+    portalHalfW_ = levelHeader_.portalHalfW;
+    portalHalfL_ = levelHeader_.portalHalfL;
+    portalTriggered_ = false;
 
-     // Village fence (doesn't block gate opening )
-     objects_.push_back(std::make_unique<Obstacle>(-120.f, -158.f, 0.5f, 25.5f)); // south fence
-     objects_.push_back(std::make_unique<Obstacle>(-120.f, -92.f, 0.5f, 25.5f));  // north fence
-     objects_.push_back(std::make_unique<Obstacle>(-160.f, -185.f, 40.f, 0.5f));  // west fence
-     objects_.push_back(std::make_unique<Obstacle>(-160.f,  -65.f, 40.f, 0.5f));  // east fence except gate gap
+    events_.clear();
+    totalPickups_ = 0;
+    collectedPickups_ = 0;
 
-     // Castle fence (gate at 0,100)
-     objects_.push_back(std::make_unique<Obstacle>(27.f, 100.f, 22.f, 1.f)); // north wall
-     objects_.push_back(std::make_unique<Obstacle>(-20.f, 100.f, 15.f, 1.f));  // south wall
-     objects_.push_back(std::make_unique<Obstacle>(50.f, 150.f, 1.f, 50.5f)); // west wall
-     objects_.push_back(std::make_unique<Obstacle>(-35.f, 150.f, 1.f, 50.5f));  // east wall
-    //
-    // Smelter fence (gate at 110,-120)
-     objects_.push_back(std::make_unique<Obstacle>(110.f, -110.f, 0.5f, 4.5f)); // south
-     objects_.push_back(std::make_unique<Obstacle>(110.f, -160.f, 0.5f, 35.f));  // north
-     objects_.push_back(std::make_unique<Obstacle>(155.f, -105.f, 45.f, 0.5f));  // west
-     objects_.push_back(std::make_unique<Obstacle>(155.f,-195.f, 45.f, 0.5f));  // east
+    // exact size up front: the arena does not grow
+    std::size_t objectBytes = 0;
+    for (const auto& e : level_) {
+        const bool pickup = e.kind == LevelEntityKind::SpeedBoost || e.kind == LevelEntityKind::SizeChange;
+        objectBytes += pickup ? ObjectArena::footprint<Pickup>() : ObjectArena::footprint<Obstacle>();
+    }
+    objects_.reserve(objectBytes);
+    colliders_.reserve(level_.size());
+    refs_.reserve(level_.size());
+    pickupGate_.reserve(level_.size());
+
+    // colliders in level order, so objects()[i] is level entity i
+    for (const auto& e : level_) {
+        std::uint32_t index = NoCollider;
+
+        switch (e.kind) {
+            case LevelEntityKind::SpeedBoost:
+            case LevelEntityKind::SizeChange: {
+                const bool speed = e.kind == LevelEntityKind::SpeedBoost;
+                auto& p = *objects_.create<Pickup>(speed ? Pickup::Type::SpeedBoost : Pickup::Type::SizeChange, e.x, e.z);
+                index = colliders_.add(p.bounds(), speed ? ColliderKind::SpeedBoost : ColliderKind::SizeChange);
+                refs_.push_back({&p});
+                totalPickups_++;
+                if (e.gate > 0) gates_[e.gate - 1].inputs++;
+                break;
+            }
+            case LevelEntityKind::Wall:
+            case LevelEntityKind::Fence:
+            case LevelEntityKind::Gate: {
+                auto& o = *objects_.create<Obstacle>(e.x, e.z, e.halfW, e.halfL);
+                index = colliders_.add(o.bounds(), ColliderKind::Obstacle);
+                refs_.push_back({&o});
+                if (e.kind == LevelEntityKind::Gate) gates_[e.gate - 1].obstacle = index;
+                break;
+            }
+        }
 
+        const bool gatePickup = e.kind != LevelEntityKind::Gate && e.gate > 0;
+        pickupGate_.push_back(gatePickup ? e.gate : 0);
+    }
 
+    // trigger graph: links become per-trigger lists (CSR), a missing or
+    // 'all' record needs every input
+    for (const auto& l : levelLinks_) {
+        gates_[l.to - 1].inputs++;
+        gates_[l.from - 1].linkCount++;
+    }
+    std::uint32_t linkStart = 0;
+    for (auto& gate : gates_) {
+        gate.firstLink = linkStart;
+        linkStart += gate.linkCount;
+        gate.linkCount = 0;
+        gate.need = gate.inputs;
+    }
+    gateLinks_.resize(levelLinks_.size());
+    for (const auto& l : levelLinks_) {
+        Gate& from = gates_[l.from - 1];
+        gateLinks_[from.firstLink + from.linkCount++] = l.to;
+    }
+    for (const auto& t : levelTriggers_) {
+        Gate& gate = gates_[t.trigger - 1];
+        if (t.need > 0) gate.need = std::min<int>(t.need, gate.inputs);
+    }
 
+    // objects now read their active flag from the store's bitset
+    for (std::uint32_t i = 0; i < refs_.size(); ++i) {
+        colliders_.bind(i, *refs_[i].get());
+    }
 
+    rebuildBroadphase();
 
+    if (trafficCount_ > 0) spawnTraffic(trafficCount_, trafficSeed_);
 
-    // --------------------------------------------------
-    //  GATES (ONLY THESE BLOCK INSIDE)
-    // --------------------------------------------------
+    snapshot(initial_);
+}
 
-    // Gate 1 – Village
-    {
-        auto g = std::make_unique<Obstacle>(-120.f, -125.f, 3.f, 8.f);
-        gate1Obstacle_ = g.get();
-        objects_.push_back(std::move(g));
-    }
+void World::spawnTraffic(std::size_t count, std::uint32_t seed) {
+    trafficCount_ = count;
+    trafficSeed_ = seed;
 
-    // Gate 2 – Castle
-    {
-        auto g = std::make_unique<Obstacle>(0.f, 100.f, 8.f, 3.f);
-        gate2Obstacle_ = g.get();
-        objects_.push_back(std::move(g));
+    if (count == 0 || colliders_.empty()) {
+        fleet_.clear();
+        fleet_.saveState(initial_.traffic);
+        return;
     }
 
-    // Gate 3 – Smelter
-    {
-        auto g = std::make_unique<Obstacle>(110.f, -120.f, 3.f, 8.f);
-        gate3Obstacle_ = g.get();
-        objects_.push_back(std::move(g));
+    // spawn inside the level (union of all colliders, away from the border)
+    Fleet::Area area{colliders_.minX()[0], colliders_.maxX()[0],
+                     colliders_.minZ()[0], colliders_.maxZ()[0]};
+    for (std::uint32_t i = 1; i < colliders_.size(); ++i) {
+        area.minX = std::min(area.minX, colliders_.minX()[i]);
+        area.maxX = std::max(area.maxX, colliders_.maxX()[i]);
+        area.minZ = std::min(area.minZ, colliders_.minZ()[i]);
+        area.maxZ = std::max(area.maxZ, colliders_.maxZ()[i]);
     }
+    const float margin = 5.f;
+    area.minX += margin;
+    area.maxX -= margin;
+    area.minZ += margin;
+    area.maxZ -= margin;
+
+    fleet_.spawn(count, seed, area, colliders_, grid_);
+    fleet_.saveState(initial_.traffic);
+}
+
+std::size_t World::memoryUsage() const {
+    return level_.capacity() * sizeof(LevelEntity) +
+           colliders_.memoryUsage() +
+           objects_.capacity() +
+           refs_.capacity() * sizeof(ObjectRef) +
+           pickupGate_.capacity() * sizeof(std::uint8_t) +
+           grid_.memoryUsage() +
+           bvh_.memoryUsage() +
+           candidates_.capacity() * sizeof(std::uint32_t) +
+           initial_.active.capacity() * sizeof(std::uint64_t) +
+           initial_.gateCollected.capacity() * sizeof(int) +
+           events_.capacity() * sizeof(WorldEvent) +
+           gates_.capacity() * sizeof(Gate) +
+           gateLinks_.capacity() * sizeof(std::uint8_t);
+}
+
+void World::rebuildBroadphase() {
+    grid_.build(colliders_);
+    bvh_.build(colliders_);
+}
+
+void World::collectPickup(std::uint32_t i) {
+    colliders_.setActive(i, false);
+    collectedPickups_++;
+    events_.push_back({WorldEvent::Type::PickupCollected, i});
+
+    if (const int n = pickupGate_[i]; n > 0) advanceGate(n);
+}
 
-    // --------------------------------------------------
-    //  PORTAL (NO COLLISION BLOCK INSIDE)
-    // --------------------------------------------------
-    portalX_ = -150.f;
-    portalZ_ = 120.f;
-    portalHalfW_ = 6.f;
-    portalHalfL_ = 6.f;
+void World::advanceGate(int n) {
+    // fires exactly once, when the last needed input comes in; inputs after
+    // that change nothing
+    Gate& gate = gates_[n - 1];
+    if (++gate.collected != gate.need) return;
+
+    if (gate.obstacle != NoCollider) colliders_.setActive(gate.obstacle, false);
+    events_.push_back({WorldEvent::Type::GateOpened, static_cast<std::uint32_t>(n)});
+
+    // depth is bounded by the 255 trigger numbers
+    for (std::uint32_t l = 0; l < gate.linkCount; ++l) advanceGate(gateLinks_[gate.firstLink + l]);
 }
 
 bool World::intersects(const Car::AABB& a, const GameObject::AABB& b) const {
@@ -122,46 +249,144 @@ bool World::intersects(const Car::AABB& a, const GameObject::AABB& b) const {
             a.minZ <= b.maxZ && a.maxZ >= b.minZ);
 }
 
-void World::update(float dt, const InputState& input) {
+void World::setSubstepping(float maxStepDistance, int maxSubsteps) {
+    maxStepDistance_ = std::max(0.f, maxStepDistance);
+    maxSubsteps_ = std::max(1, maxSubsteps);
+}
 
-    if (!portalTriggered_) {
-        car_.update(dt, input);
+void World::update(float dt, const InputState& input) {
+    BILSIM_PROFILE_SCOPE("World::update");
+
+    events_.clear();
+
+    int steps = 1;
+    if (maxStepDistance_ > 0.f) {
+        // the faster of the start and end speed: a car standing against a
+        // wall (speed 0) can still cover metres in a long accelerating tick
+        Car probe = car_;
+        probe.update(dt, input);
+        const float distance = std::max(std::abs(car_.speed()), std::abs(probe.speed())) * dt;
+        steps = std::clamp(static_cast<int>(std::ceil(distance / maxStepDistance_)), 1, maxSubsteps_);
     }
 
-    auto carB = car_.bounds();
-
-    // collisions
-    for (auto& obj : objects_) {
-        if (obj->isActive() && intersects(carB, obj->bounds())) {
-
-            car_.setSpeed(0.f);
+    for (int s = 0; s < steps; ++s) {
+        step(dt / static_cast<float>(steps), input);
+    }
+}
 
-            obj->onCarOverlap(car_);
+std::uint32_t World::sweepCar(Vec2 from) {
+    const Vec2 to = car_.position();
+    const float dx = to.x - from.x;
+    const float dz = to.z - from.z;
+    // the rotated car's enclosing box is what moves
+    const Car::OBB carBox = car_.orientedBounds();
+    const float halfW = carBox.extentX();
+    const float halfL = carBox.extentZ();
+
+    // a shorter move cannot carry the car's centre past the middle of a
+    // wall, so the overlap pass still pushes it back out on the near side
+    if (std::abs(dx) < halfW && std::abs(dz) < halfL) return NoCollider;
+
+    const Car::AABB start{from.x - halfW, from.x + halfW, from.z - halfL, from.z + halfL};
+    const Car::AABB swept{std::min(start.minX, start.minX + dx), std::max(start.maxX, start.maxX + dx),
+                          std::min(start.minZ, start.minZ + dz), std::max(start.maxZ, start.maxZ + dz)};
+    grid_.queryOverlaps(swept, candidates_);
+
+    // first wall on the way. A wall already touched at the start stops
+    // the car at once if the move heads into it (a car resting against
+    // the border would otherwise be swept straight through); moving away
+    // or along it is left to the overlap pass.
+    std::uint32_t wall = NoCollider;
+    float stop = 1.f;
+    SweepHit hit;
+    for (auto i : candidates_) {
+        if (!colliders_.isActive(i) || colliders_.kind(i) != ColliderKind::Obstacle ||
+            !sweepAabb(start, dx, dz, colliders_.bounds(i), hit)) {
+            continue;
+        }
+        float enter = hit.enter;
+        if (enter <= 0.f) {
+            if (!movesInto(start, dx, dz, colliders_.bounds(i))) continue;
+            enter = 0.f;
+        }
+        if (enter < stop) {
+            wall = i;
+            stop = enter;
         }
     }
 
-    // Gate logic
-    auto collected = [&](Pickup* A, Pickup* B) {
-        return A && B && !A->isActive() && !B->isActive();
-    };
+    // pickups passed before that (the ones under the end position are left
+    // to the overlap pass, so none is taken twice)
+    const Car::AABB end{start.minX + dx * stop, start.maxX + dx * stop,
+                        start.minZ + dz * stop, start.maxZ + dz * stop};
+    for (auto i : candidates_) {
+        const ColliderKind kind = colliders_.kind(i);
+        if (kind == ColliderKind::Obstacle || !colliders_.isActive(i) ||
+            !sweepAabb(start, dx, dz, colliders_.bounds(i), hit) || hit.enter > stop ||
+            intersects(end, colliders_.bounds(i))) {
+            continue;
+        }
+        car_.setSpeed(0.f);
+        Pickup::applyEffect(kind == ColliderKind::SpeedBoost ? Pickup::Type::SpeedBoost : Pickup::Type::SizeChange, car_);
+        collectPickup(i);
+    }
 
-    if (gate1Obstacle_ && gate1Obstacle_->isActive() &&
-        collected(gate1PickupA_, gate1PickupB_)) {
-        gate1Obstacle_->deactivate();
+    if (wall != NoCollider) {
+        // stop where the enclosing box touches; resolve() snaps an aligned
+        // car exactly onto the face (a rotated one may stop a little short)
+        car_.setPosition(from.x + dx * stop, from.z + dz * stop);
+        Obstacle::resolve(colliders_.bounds(wall), car_);
+        car_.setSpeed(0.f);
+        events_.push_back({WorldEvent::Type::CollisionContact, wall});
     }
+    return wall;
+}
 
-    if (gate2Obstacle_ && gate2Obstacle_->isActive() &&
-        collected(gate2PickupA_, gate2PickupB_)) {
-        gate2Obstacle_->deactivate();
+void World::step(float dt, const InputState& input) {
+
+    std::uint32_t swept = NoCollider;
+    if (!portalTriggered_) {
+        const Vec2 from = car_.position();
+        car_.update(dt, input);
+        swept = sweepCar(from);
     }
 
-    if (gate3Obstacle_ && gate3Obstacle_->isActive() &&
-        collected(gate3PickupA_, gate3PickupB_)) {
-        gate3Obstacle_->deactivate();
+    const Car::OBB carBox = car_.orientedBounds();
+    const Car::AABB carB = carBox.enclosing();
+
+    // collisions: grid cells under the car's enclosing box, SIMD AABB test
+    // and then SAT on the rotated box per cell, narrowphase only for hits
+    // (in the same index order a full scan would visit them)
+    grid_.queryOverlaps(carBox, candidates_);
+
+    for (auto i : candidates_) {
+        if (colliders_.isActive(i) && i != swept) {
+
+            car_.setSpeed(0.f);
+
+            // narrowphase dispatch on the type tag (no virtual call)
+            switch (colliders_.kind(i)) {
+                case ColliderKind::Obstacle:
+                    Obstacle::resolve(colliders_.bounds(i), car_);
+                    events_.push_back({WorldEvent::Type::CollisionContact, i});
+                    break;
+                case ColliderKind::SpeedBoost:
+                    Pickup::applyEffect(Pickup::Type::SpeedBoost, car_);
+                    collectPickup(i);
+                    break;
+                case ColliderKind::SizeChange:
+                    Pickup::applyEffect(Pickup::Type::SizeChange, car_);
+                    collectPickup(i);
+                    break;
+            }
+        }
     }
 
+    // AI traffic: own integrator + static and car-vs-car collisions
+    fleet_.update(dt, colliders_, grid_, car_);
+
     // Portal
-    if (!portalTriggered_) {
+    if (!portalTriggered_ && portalHalfW_ > 0.f) {
         GameObject::AABB portalBox{
             portalX_ - portalHalfW_, portalX_ + portalHalfW_,
             portalZ_ - portalHalfL_, portalZ_ + portalHalfL_
@@ -169,28 +394,14 @@ void World::update(float dt, const InputState& input) {
 
         if (intersects(carB, portalBox)) {
             portalTriggered_ = true;
+            events_.push_back({WorldEvent::Type::PortalEntered});
         }
     }
 }
 
-bool World::gate1IsOpen() const { return !gate1Obstacle_ || !gate1Obstacle_->isActive(); }
-bool World::gate2IsOpen() const { return !gate2Obstacle_ || !gate2Obstacle_->isActive(); }
-bool World::gate3IsOpen() const { return !gate3Obstacle_ || !gate3Obstacle_->isActive(); }
-
-int World::totalPickups() const {
-    int c = 0;
-    for (auto& o : objects_) if (dynamic_cast<Pickup*>(o.get())) c++;
-    return c;
-}
-
-int World::collectedPickups() const {
-    int c = 0;
-    for (auto& o : objects_) {
-        if (auto p = dynamic_cast<Pickup*>(o.get())) {
-            if (!p->isActive()) c++;
-        }
-    }
-    return c;
+bool World::gateIsOpen(int gate) const {
+    if (gate < 1 || gate > gateCount()) return true;
+    return gates_[gate - 1].fired();
 }
 
 bool World::allPickupsCollected() const {
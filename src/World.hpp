@@ -3,64 +3,187 @@
 #pragma once
 
 #include <vector>
-#include <memory>
+#include <span>
 
 #include "Car.hpp"
 #include "GameObject.hpp"
+#include "ColliderStore.hpp"
+#include "ColliderBvh.hpp"
+#include "CollisionGrid.hpp"
+#include "Fleet.hpp"
+#include "Level.hpp"
+#include "ObjectArena.hpp"
+#include "Obstacle.hpp"
+#include "Pickup.hpp"
+#include "WorldEvent.hpp"
 
-class Obstacle; // forward declaration
-class Pickup;   // forward declaration
+// Read-only view over the world's objects (index i matches collider i)
+using ObjectView = std::span<const ObjectRef>;
+using EventView = std::span<const WorldEvent>;
+
+// Everything World::update changes, as flat copies: car, traffic, collider
+// active bits and gate/portal progress. Restoring one into the world it was
+// taken from (same level and traffic count) copies the buffers back without
+// allocating or rebuilding any objects.
+struct WorldSnapshot {
+    Car car;
+    std::vector<std::uint64_t> active;
+    std::vector<int> gateCollected;
+    Fleet::State traffic;
+    int collectedPickups = 0;
+    bool portalTriggered = false;
+};
 
 class World {
 public:
-    World();
+    World();  // default level
+    explicit World(const LevelView& level);
+
+    // objects() and the collider bindings point into this instance
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+    World(World&&) = default;
+    World& operator=(World&&) = default;
+
+    // Replaces the layout (copies the level records) and rebuilds the world
+    void load(const LevelView& level);
+
+    // One tick. Car moves long enough to pass through a wall are swept
+    // (see sweepCar); with substepping on, fast ticks are also split.
     void update(float dt, const InputState& input);
+
+    // Adaptive substepping: a tick whose car would travel more than
+    // maxStepDistance metres (at the faster of its start and end speed)
+    // runs as up to maxSubsteps equal steps. 0 = off (the default). Part
+    // of the simulation: a recording only replays with the same setting.
+    void setSubstepping(float maxStepDistance, int maxSubsteps = 8);
+    float maxStepDistance() const { return maxStepDistance_; }
+    int maxSubsteps() const { return maxSubsteps_; }
+
+    // Back to the state right after load()/spawnTraffic(); a restore, no rebuild
     void reset();
 
+    // Save/rewind the simulation state. snapshot(out) reuses out's buffers;
+    // restore() returns false if the snapshot is from a different layout.
+    void snapshot(WorldSnapshot& out) const;
+    WorldSnapshot snapshot() const;
+    bool restore(const WorldSnapshot& snapshot);
+
     Car& car() { return car_; }
     const Car& car() const { return car_; }
 
-    const std::vector<std::unique_ptr<GameObject>>& objects() const { return objects_; }
+    // AI traffic (player car stays car()); reset() returns it to the spawn
+    void spawnTraffic(std::size_t count, std::uint32_t seed = 1);
+    const Fleet& traffic() const { return fleet_; }
+
+    // Bytes held by the level copy, colliders, objects, broadphase and
+    // buffers (capacity, traffic not included); for scaling reports
+    std::size_t memoryUsage() const;
+
+    ObjectView objects() const { return refs_; }
+    const ColliderStore& colliders() const { return colliders_; }
+
+    // Lidar: shortens each ray of the fan to the nearest active obstacle
+    // (walls, fences, closed gates) and writes its collider index to hits
+    // (ColliderBvh::NoHit if clear). Read-only, safe from several threads.
+    void castRays(RayFan& rays, std::uint32_t* hits = nullptr) const {
+        bvh_.castRays(colliders_, rays, hits);
+    }
 
-    // Gate state (for doors in main.cpp)
-    bool gate1IsOpen() const; // village gate
-    bool gate2IsOpen() const; // castle gate
-    bool gate3IsOpen() const; // smelter gate
+    // Gate state (for doors in main.cpp), gates are numbered from 1. Gate n
+    // is open once trigger n has fired (see LevelTrigger); numbers without
+    // a gate are pure triggers.
+    int gateCount() const { return static_cast<int>(gates_.size()); }
+    bool gateIsOpen(int gate) const;
+    bool gate1IsOpen() const { return gateIsOpen(1); } // village gate
+    bool gate2IsOpen() const { return gateIsOpen(2); } // castle gate
+    bool gate3IsOpen() const { return gateIsOpen(3); } // smelter gate
 
     // Portal state (for end scene)
     bool portalTriggered() const { return portalTriggered_; }
     Vec2 portalCenter() const { return {portalX_, portalZ_}; }
 
-    // Pickup info (for potential UI)
-    int totalPickups() const;
-    int collectedPickups() const;
+    // What changed during the last update() (cleared when the next one starts)
+    EventView events() const { return events_; }
+
+    // Pickup info (for potential UI), counted as they change
+    int totalPickups() const { return totalPickups_; }
+    int collectedPickups() const { return collectedPickups_; }
     bool allPickupsCollected() const;
 
 private:
+    static constexpr std::uint32_t NoCollider = 0xFFFFFFFFu;
+
     Car car_;
-    std::vector<std::unique_ptr<GameObject>> objects_;
 
-    // gate obstacles (logical blockers)
-    Obstacle* gate1Obstacle_ = nullptr;
-    Obstacle* gate2Obstacle_ = nullptr;
-    Obstacle* gate3Obstacle_ = nullptr;
+    // layout the world is (re)built from
+    LevelHeader levelHeader_{};
+    std::vector<LevelEntity> level_;
+    std::vector<LevelTrigger> levelTriggers_;
+    std::vector<LevelTriggerLink> levelLinks_;
+
+    // hot collision data (SoA); the GameObjects below only own the objects
+    // and back the objects() view, the tick never walks them. They sit in
+    // one arena in level order; reset() leaves them alone and load()
+    // rewinds the arena, reusing its block.
+    ColliderStore colliders_;
+    ObjectArena objects_;
+    std::vector<ObjectRef> refs_;
+    std::vector<std::uint8_t> pickupGate_; // per collider, 0 = not a gate pickup
+
+    // broadphase over colliders_ (rebuilt in reset) + per-tick hit list
+    CollisionGrid grid_;
+    std::vector<std::uint32_t> candidates_;
+
+    // obstacles for ray casts, built with the grid; opened gates are
+    // skipped through their active bit, so it outlives every reset
+    ColliderBvh bvh_;
+
+    float maxStepDistance_ = 0.f;
+    int maxSubsteps_ = 8;
+
+    // state reset() returns to
+    WorldSnapshot initial_;
+
+    // event buffer, reused every tick
+    std::vector<WorldEvent> events_;
+    int totalPickups_ = 0;
+    int collectedPickups_ = 0;
+
+    Fleet fleet_;
+    std::size_t trafficCount_ = 0;
+    std::uint32_t trafficSeed_ = 1;
+
+    // gates[n - 1]: trigger n and its blocking collider. Only a collected
+    // pickup (or a trigger firing into this one) touches it, so a tick
+    // without pickups costs nothing here, however many gates there are.
+    struct Gate {
+        std::uint32_t obstacle = NoCollider;
+        int inputs = 0;       // pickups + triggers linked into this one
+        int need = 0;         // fires when collected reaches it (0 = never)
+        int collected = 0;    // inputs done
+        std::uint32_t firstLink = 0; // gateLinks_[firstLink .. + linkCount): triggers this one feeds
+        std::uint32_t linkCount = 0;
 
-    // pickups that control each gate (two per gate)
-    Pickup* gate1PickupA_ = nullptr;
-    Pickup* gate1PickupB_ = nullptr;
-    Pickup* gate2PickupA_ = nullptr;
-    Pickup* gate2PickupB_ = nullptr;
-    Pickup* gate3PickupA_ = nullptr;
-    Pickup* gate3PickupB_ = nullptr;
+        bool fired() const { return need > 0 && collected >= need; }
+    };
+    std::vector<Gate> gates_;
+    std::vector<std::uint8_t> gateLinks_;    // trigger numbers fit a byte (MaxGateCount)
 
     // portal zone inside mountain
     float portalX_ = 0.f;
     float portalZ_ = 0.f;
-    float portalHalfW_ = 4.f;
-    float portalHalfL_ = 4.f;
+    float portalHalfW_ = 0.f;  // 0 = level has no portal
+    float portalHalfL_ = 0.f;
     bool portalTriggered_ = false;
 
     bool intersects(const Car::AABB& a, const GameObject::AABB& b) const;
+    void build();
+    void rebuildBroadphase();
+    void collectPickup(std::uint32_t i);
+    void advanceGate(int n);
+    void step(float dt, const InputState& input);
+    std::uint32_t sweepCar(Vec2 from);
 };
 
 #endif //BIL_SIMULATOR_JOHN_MITCHEL_WORLD_HPP
@@ -0,0 +1,21 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_WORLDEVENT_HPP
+#define BIL_SIMULATOR_JOHN_MITCHEL_WORLDEVENT_HPP
+#pragma once
+
+#include <cstdint>
+
+// Something that changed during one World::update.
+// The renderer drains these instead of polling every object each frame.
+struct WorldEvent {
+    enum class Type : std::uint8_t {
+        PickupCollected,  // id = collider index (same index as objects())
+        GateOpened,       // id = gate number (1 village, 2 castle, 3 smelter)
+        PortalEntered,    // id unused
+        CollisionContact  // id = collider index of the obstacle the car hit
+    };
+
+    Type type;
+    std::uint32_t id = 0;
+};
+
+#endif //BIL_SIMULATOR_JOHN_MITCHEL_WORLDEVENT_HPP
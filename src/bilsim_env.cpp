@@ -0,0 +1,148 @@
+#include "bilsim_env.h"
+#include "VecEnv.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+
+static_assert(int(BILSIM_OBS_SIZE) == int(VecEnv::ObsSize) && int(BILSIM_OBS_CONTACT) == int(VecEnv::Contact),
+              "bilsim_env.h and VecEnv.hpp disagree on the observation layout");
+static_assert(int(BILSIM_OBS_LIDAR) == int(VecEnv::Lidar), "lidar offset differs");
+static_assert(int(BILSIM_ACTION_TURN_RIGHT) == int(VecEnv::TurnRight), "action bits differ");
+
+struct bilsim_env {
+    LevelFile level;
+    std::unique_ptr<VecEnv> env;
+};
+
+namespace {
+
+void setError(char* error, std::size_t size, const std::string& message) {
+    if (!error || size == 0) return;
+    const std::size_t n = std::min(size - 1, message.size());
+    std::memcpy(error, message.data(), n);
+    error[n] = '\0';
+}
+
+}
+
+extern "C" {
+
+void bilsim_env_default_config(bilsim_env_config* config) {
+    if (!config) return;
+    const VecEnv::Config d;
+    *config = {};
+    config->batch = static_cast<std::uint32_t>(d.batch);
+    config->threads = d.threads;
+    config->dt = d.dt;
+    config->frame_skip = d.frameSkip;
+    config->max_steps = d.maxSteps;
+    config->auto_reset = d.autoReset ? 1 : 0;
+    config->level_path = nullptr;
+    config->pickup_reward = d.pickupReward;
+    config->gate_reward = d.gateReward;
+    config->portal_reward = d.portalReward;
+    config->contact_reward = d.contactReward;
+    config->progress_reward = d.progressReward;
+    config->lidar_rays = d.lidarRays;
+    config->lidar_fov = d.lidarFov;
+    config->lidar_range = d.lidarRange;
+}
+
+bilsim_env* bilsim_env_create(const bilsim_env_config* config, char* error, std::size_t error_size) {
+    bilsim_env_config c;
+    if (config) c = *config;
+    else bilsim_env_default_config(&c);
+
+    if (c.batch == 0) {
+        setError(error, error_size, "batch must be at least 1");
+        return nullptr;
+    }
+    if (!(c.dt > 0.f)) {
+        setError(error, error_size, "dt must be positive");
+        return nullptr;
+    }
+    if (c.lidar_rays > RayFan::MaxRays) {
+        setError(error, error_size, "lidar_rays must be at most 64");
+        return nullptr;
+    }
+    if (c.lidar_rays > 0 && !(c.lidar_range > 0.f)) {
+        setError(error, error_size, "lidar_range must be positive");
+        return nullptr;
+    }
+
+    // no exception may cross the C boundary
+    try {
+        auto handle = std::make_unique<bilsim_env>();
+        const LevelView* level = &LevelFile::defaultLevel().view();
+        if (c.level_path) {
+            std::string message;
+            if (!handle->level.open(c.level_path, &message)) {
+                setError(error, error_size, message);
+                return nullptr;
+            }
+            level = &handle->level.view();
+        }
+
+        VecEnv::Config vc;
+        vc.batch = c.batch;
+        vc.threads = c.threads;
+        vc.dt = c.dt;
+        vc.frameSkip = c.frame_skip;
+        vc.maxSteps = c.max_steps;
+        vc.autoReset = c.auto_reset != 0;
+        vc.pickupReward = c.pickup_reward;
+        vc.gateReward = c.gate_reward;
+        vc.portalReward = c.portal_reward;
+        vc.contactReward = c.contact_reward;
+        vc.progressReward = c.progress_reward;
+        vc.lidarRays = c.lidar_rays;
+        vc.lidarFov = c.lidar_fov;
+        vc.lidarRange = c.lidar_range;
+
+        handle->env = std::make_unique<VecEnv>(*level, vc);
+        return handle.release();
+    } catch (const std::exception& e) {
+        setError(error, error_size, e.what());
+        return nullptr;
+    }
+}
+
+void bilsim_env_destroy(bilsim_env* env) {
+    delete env;
+}
+
+std::uint32_t bilsim_env_batch(const bilsim_env* env) {
+    return env ? static_cast<std::uint32_t>(env->env->batch()) : 0;
+}
+
+std::uint32_t bilsim_env_obs_size(const bilsim_env* env) {
+    return env ? static_cast<std::uint32_t>(env->env->obsSize()) : 0;
+}
+
+void bilsim_env_reset(bilsim_env* env, const std::uint8_t* mask) {
+    if (!env) return;
+    if (mask) env->env->reset({mask, env->env->batch()});
+    else env->env->reset();
+}
+
+void bilsim_env_step(bilsim_env* env, const std::uint8_t* actions) {
+    if (!env || !actions) return;
+    env->env->step({actions, env->env->batch()});
+}
+
+const float* bilsim_env_observations(const bilsim_env* env) {
+    return env ? env->env->observations().data() : nullptr;
+}
+
+const float* bilsim_env_rewards(const bilsim_env* env) {
+    return env ? env->env->rewards().data() : nullptr;
+}
+
+const std::uint8_t* bilsim_env_dones(const bilsim_env* env) {
+    return env ? env->env->dones().data() : nullptr;
+}
+
+}
@@ -0,0 +1,118 @@
+#ifndef BIL_SIMULATOR_JOHN_MITCHEL_BILSIM_ENV_H
+#define BIL_SIMULATOR_JOHN_MITCHEL_BILSIM_ENV_H
+#pragma once
+
+/*
+ * C API of the batched training environment (libbilsim_env), for ctypes,
+ * cffi or any other FFI. B worlds on one level are stepped together and
+ * split across the cores; see VecEnv.hpp for the C++ side.
+ *
+ *   bilsim_env_config config;
+ *   bilsim_env_default_config(&config);
+ *   config.batch = 1024;
+ *   bilsim_env* env = bilsim_env_create(&config, NULL, 0);   // reset done
+ *
+ *   const float* obs = bilsim_env_observations(env);        // batch * obs_size
+ *   bilsim_env_step(env, actions);                          // batch bytes
+ *   ... bilsim_env_rewards(env), bilsim_env_dones(env) ...
+ *
+ *   bilsim_env_destroy(env);
+ *
+ * The buffers are owned by the env, allocated once and overwritten by
+ * every step/reset; they stay valid until bilsim_env_destroy. An env must
+ * not be used from two threads at once.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(BILSIM_ENV_BUILD)
+#    define BILSIM_ENV_API __declspec(dllexport)
+#  else
+#    define BILSIM_ENV_API __declspec(dllimport)
+#  endif
+#else
+#  define BILSIM_ENV_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Action byte: any combination of these bits (0 = coast) */
+enum {
+    BILSIM_ACTION_ACCELERATE = 1,
+    BILSIM_ACTION_BRAKE = 2,
+    BILSIM_ACTION_TURN_LEFT = 4,
+    BILSIM_ACTION_TURN_RIGHT = 8
+};
+
+/* Observation row: bilsim_env_obs_size floats per world, the values
+   below, then lidar_rays distances from BILSIM_OBS_LIDAR on */
+enum {
+    BILSIM_OBS_POS_X,           /* -1..1 over the level's bounds */
+    BILSIM_OBS_POS_Z,
+    BILSIM_OBS_HEADING_SIN,     /* car forward vector */
+    BILSIM_OBS_HEADING_COS,
+    BILSIM_OBS_SPEED,           /* / 50 m/s */
+    BILSIM_OBS_SCALE,
+    BILSIM_OBS_PICKUPS_LEFT,    /* fraction */
+    BILSIM_OBS_GATES_OPEN,      /* fraction */
+    BILSIM_OBS_PORTAL_LEFT,     /* unit direction to the portal in the car's frame */
+    BILSIM_OBS_PORTAL_AHEAD,
+    BILSIM_OBS_PORTAL_DISTANCE, /* / level diagonal */
+    BILSIM_OBS_CONTACT,         /* 1 if the car hit an obstacle during the step */
+    BILSIM_OBS_SIZE,            /* without the lidar */
+    BILSIM_OBS_LIDAR = BILSIM_OBS_SIZE /* / lidar_range, 1 = nothing in range */
+};
+
+typedef struct bilsim_env bilsim_env;
+
+typedef struct bilsim_env_config {
+    uint32_t batch;             /* worlds */
+    uint32_t threads;           /* 0 = all cores */
+    float dt;                   /* seconds per world update */
+    uint32_t frame_skip;        /* world updates per step */
+    uint32_t max_steps;         /* episode length, 0 = until the portal */
+    uint32_t auto_reset;        /* non-zero: finished worlds restart inside step */
+    const char* level_path;     /* text or binary level, NULL = built-in level */
+
+    float pickup_reward;
+    float gate_reward;
+    float portal_reward;
+    float contact_reward;       /* per update with an obstacle contact */
+    float progress_reward;      /* per metre closer to the portal */
+
+    uint32_t lidar_rays;        /* 0..64 rays from the car, 0 = no lidar */
+    float lidar_fov;            /* radians, ray 0 on the left edge */
+    float lidar_range;          /* metres */
+} bilsim_env_config;
+
+/* Fills in the defaults (batch 1, 60 Hz, auto reset, built-in level,
+   no lidar) */
+BILSIM_ENV_API void bilsim_env_default_config(bilsim_env_config* config);
+
+/* NULL on failure, with the reason in error (if given) */
+BILSIM_ENV_API bilsim_env* bilsim_env_create(const bilsim_env_config* config, char* error, size_t error_size);
+BILSIM_ENV_API void bilsim_env_destroy(bilsim_env* env);
+
+BILSIM_ENV_API uint32_t bilsim_env_batch(const bilsim_env* env);
+BILSIM_ENV_API uint32_t bilsim_env_obs_size(const bilsim_env* env);
+
+/* Restarts the worlds whose mask byte is non-zero; mask NULL = all */
+BILSIM_ENV_API void bilsim_env_reset(bilsim_env* env, const uint8_t* mask);
+
+/* One action byte per world. With auto_reset a finished world reports its
+   last reward and done = 1, and its observation row shows the new episode. */
+BILSIM_ENV_API void bilsim_env_step(bilsim_env* env, const uint8_t* actions);
+
+BILSIM_ENV_API const float* bilsim_env_observations(const bilsim_env* env);  /* batch * obs_size */
+BILSIM_ENV_API const float* bilsim_env_rewards(const bilsim_env* env);       /* batch */
+BILSIM_ENV_API const uint8_t* bilsim_env_dones(const bilsim_env* env);       /* batch */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BIL_SIMULATOR_JOHN_MITCHEL_BILSIM_ENV_H */
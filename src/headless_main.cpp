@@ -0,0 +1,350 @@
+#include "Game.hpp"
+#include "Level.hpp"
+#include "InputRecording.hpp"
+#include "ThreadPool.hpp"
+#include "InputState.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// -----------------------------------------------------
+// Headless batch runner: many independent worlds, no window
+//
+//   bilsim_headless [--worlds N] [--steps N] [--threads N]
+//                   [--dt SECONDS] [--seed N] [--script FILE]
+//                   [--traffic N] [--level FILE]
+//                   [--record FILE] [--replay FILE] [--max-step METRES]
+//
+// Without --script every world drives with its own random input sequence.
+// A script is a text file with one "<ticks> <keys>" entry per line, where
+// keys is any combination of W/A/S/D (or '-' for no input), e.g.
+//     120 W
+//     30  WA
+//     60  -
+// The script loops if a run has more steps than the script.
+// --level takes a binary (bilsim_levelc) or text level; default is the
+// built-in level.
+//
+// --record writes the input of world 0 as a recording. --replay runs a
+// recording (from here or from the game's --record) in every world as fast
+// as possible and checks the final state against its checksum; the exit
+// code is 1 if any world ends differently. Steps and traffic then come
+// from the recording.
+//
+// --max-step turns on adaptive substepping: a tick in which the car would
+// move further than METRES is split (see World::setSubstepping), so a
+// coarse --dt stays close to the 60 Hz result. Recordings store it, and
+// --replay uses the recorded value instead.
+// -----------------------------------------------------
+
+namespace {
+
+struct Options {
+    std::size_t worlds = 1000;
+    std::size_t steps = 600;
+    unsigned threads = std::thread::hardware_concurrency();
+    float dt = 1.f / 60.f;
+    std::uint32_t seed = 1;
+    std::string scriptPath;
+    std::size_t traffic = 0;
+    std::string levelPath;
+    std::string recordPath;
+    std::string replayPath;
+    float maxStep = 0.f;
+};
+
+struct ScriptEntry {
+    int ticks = 0;
+    InputState input;
+};
+
+struct RunResult {
+    float x = 0.f;
+    float z = 0.f;
+    int pickups = 0;
+    int gatesOpen = 0;
+    bool portal = false;
+    bool replayOk = true;
+    std::uint64_t ticks = 0;   // simulated (a world stops at the portal)
+};
+
+InputState parseKeys(const std::string& keys) {
+    InputState in;
+    for (char c : keys) {
+        switch (c) {
+            case 'W': case 'w': in.accelerate = true; break;
+            case 'S': case 's': in.brake = true; break;
+            case 'A': case 'a': in.turnLeft = true; break;
+            case 'D': case 'd': in.turnRight = true; break;
+            default: break;
+        }
+    }
+    return in;
+}
+
+bool loadScript(const std::string& path, std::vector<ScriptEntry>& out) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream ss(line);
+        ScriptEntry e;
+        std::string keys;
+        if (!(ss >> e.ticks)) continue;
+        ss >> keys;
+        e.input = parseKeys(keys);
+        if (e.ticks > 0) out.push_back(e);
+    }
+    return !out.empty();
+}
+
+// Random driver: holds a random key combination for a random number of ticks.
+// Mostly accelerating, so worlds actually travel and hit things.
+class RandomDriver {
+public:
+    explicit RandomDriver(std::uint32_t seed) : rng_(seed) {}
+
+    InputState next() {
+        if (holdTicks_ <= 0) {
+            std::uniform_int_distribution<int> hold(10, 90);
+            std::uniform_int_distribution<int> pct(0, 99);
+            holdTicks_ = hold(rng_);
+            current_ = {};
+            current_.accelerate = pct(rng_) < 75;
+            current_.brake = !current_.accelerate && pct(rng_) < 40;
+            int turn = pct(rng_);
+            current_.turnLeft = turn < 30;
+            current_.turnRight = turn >= 70;
+        }
+        --holdTicks_;
+        return current_;
+    }
+
+private:
+    std::mt19937 rng_;
+    InputState current_{};
+    int holdTicks_ = 0;
+};
+
+RunResult summarize(const World& w) {
+    RunResult r;
+    r.x = w.car().position().x;
+    r.z = w.car().position().z;
+    r.pickups = w.collectedPickups();
+    for (int g = 1; g <= w.gateCount(); ++g) r.gatesOpen += int(w.gateIsOpen(g));
+    r.portal = w.portalTriggered();
+    return r;
+}
+
+RunResult replayWorld(const LevelView& level, const InputRecording& recording) {
+    Game game(level);
+    const bool ok = recording.replay(game);
+
+    RunResult r = summarize(game.world());
+    r.replayOk = ok;
+    r.ticks = recording.tickCount();
+    return r;
+}
+
+RunResult runWorld(const Options& opt, const LevelView& level,
+                   const std::vector<ScriptEntry>& script, std::size_t index,
+                   InputRecording* recorder) {
+    Game game(level);
+    game.world().setSubstepping(opt.maxStep);
+    const auto trafficSeed = opt.seed + static_cast<std::uint32_t>(index);
+    if (opt.traffic > 0) {
+        game.world().spawnTraffic(opt.traffic, trafficSeed);
+    }
+    if (recorder) {
+        recorder->begin(opt.dt, level.hash(), static_cast<std::uint32_t>(opt.traffic), trafficSeed,
+                        game.world().maxStepDistance(), game.world().maxSubsteps());
+    }
+
+    RandomDriver driver(opt.seed + static_cast<std::uint32_t>(index) * 7919u);
+
+    std::size_t entry = 0;
+    int entryTick = 0;
+    std::uint64_t ticks = 0;
+
+    for (std::size_t step = 0; step < opt.steps; ++step) {
+        InputState input;
+        if (script.empty()) {
+            input = driver.next();
+        } else {
+            input = script[entry].input;
+            if (++entryTick >= script[entry].ticks) {
+                entryTick = 0;
+                entry = (entry + 1) % script.size();
+            }
+        }
+
+        if (!game.world().portalTriggered()) {
+            if (recorder) recorder->record(input);
+            game.update(opt.dt, input);
+            ticks++;
+        }
+    }
+
+    if (recorder) recorder->finish(game.world());
+    RunResult r = summarize(game.world());
+    r.ticks = ticks;
+    return r;
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            return (i + 1 < argc) ? argv[++i] : nullptr;
+        };
+
+        const char* v = nullptr;
+        if (arg == "--worlds" && (v = value())) opt.worlds = std::strtoull(v, nullptr, 10);
+        else if (arg == "--steps" && (v = value())) opt.steps = std::strtoull(v, nullptr, 10);
+        else if (arg == "--threads" && (v = value())) opt.threads = unsigned(std::strtoul(v, nullptr, 10));
+        else if (arg == "--dt" && (v = value())) opt.dt = std::strtof(v, nullptr);
+        else if (arg == "--seed" && (v = value())) opt.seed = std::uint32_t(std::strtoul(v, nullptr, 10));
+        else if (arg == "--script" && (v = value())) opt.scriptPath = v;
+        else if (arg == "--traffic" && (v = value())) opt.traffic = std::strtoull(v, nullptr, 10);
+        else if (arg == "--level" && (v = value())) opt.levelPath = v;
+        else if (arg == "--record" && (v = value())) opt.recordPath = v;
+        else if (arg == "--replay" && (v = value())) opt.replayPath = v;
+        else if (arg == "--max-step" && (v = value())) opt.maxStep = std::strtof(v, nullptr);
+        else {
+            std::cerr << "Unknown or incomplete argument: " << arg << "\n"
+                      << "Usage: bilsim_headless [--worlds N] [--steps N] [--threads N]"
+                         " [--dt SECONDS] [--seed N] [--script FILE] [--traffic N] [--level FILE]"
+                         " [--record FILE] [--replay FILE] [--max-step METRES]\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+// -----------------------------------------------------
+// MAIN
+// -----------------------------------------------------
+
+int main(int argc, char** argv) {
+
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 1;
+
+    std::vector<ScriptEntry> script;
+    if (!opt.scriptPath.empty() && !loadScript(opt.scriptPath, script)) {
+        std::cerr << "Failed to load script: " << opt.scriptPath << "\n";
+        return 1;
+    }
+
+    // one mapping shared (read-only) by every world
+    LevelFile levelFile;
+    const LevelView* level = &LevelFile::defaultLevel().view();
+    if (!opt.levelPath.empty()) {
+        std::string error;
+        if (!levelFile.open(opt.levelPath, &error)) {
+            std::cerr << "Failed to load level " << opt.levelPath << ": " << error << "\n";
+            return 1;
+        }
+        level = &levelFile.view();
+    }
+
+    InputRecording replay;
+    if (!opt.replayPath.empty()) {
+        std::string error;
+        if (!replay.load(opt.replayPath, &error)) {
+            std::cerr << "Failed to load recording " << opt.replayPath << ": " << error << "\n";
+            return 1;
+        }
+        if (replay.levelHash() != level->hash()) {
+            std::cerr << "Recording was made on a different level (use --level)\n";
+            return 1;
+        }
+        opt.steps = replay.tickCount();
+        opt.traffic = replay.trafficCount();
+        opt.maxStep = replay.maxStepDistance();
+    }
+
+    InputRecording recorder;
+    const bool recording = !opt.recordPath.empty() && opt.replayPath.empty();
+
+    std::vector<RunResult> results(opt.worlds);
+
+    ThreadPool pool(opt.threads);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Small chunks so idle workers have something to steal near the end
+    pool.parallelFor(opt.worlds, 4, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!opt.replayPath.empty()) {
+                results[i] = replayWorld(*level, replay);
+            } else {
+                results[i] = runWorld(opt, *level, script, i, (recording && i == 0) ? &recorder : nullptr);
+            }
+        }
+    });
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    // --- Aggregate report ---
+    long long pickups = 0;
+    long long gates = 0;
+    std::size_t portals = 0;
+    std::size_t mismatches = 0;
+    double checksum = 0.0;
+    std::uint64_t totalSteps = 0;
+    for (const auto& r : results) {
+        totalSteps += r.ticks;
+        mismatches += r.replayOk ? 0 : 1;
+        pickups += r.pickups;
+        gates += r.gatesOpen;
+        portals += r.portal ? 1 : 0;
+        checksum += double(r.x) + double(r.z);
+    }
+
+    std::cout << "worlds:        " << opt.worlds << "\n"
+              << "steps/world:   " << opt.steps << "\n"
+              << "steps run:     " << totalSteps << " (worlds stop at the portal)\n"
+              << "threads:       " << pool.size() << "\n"
+              << "input:         " << (!opt.replayPath.empty() ? opt.replayPath
+                                       : script.empty() ? std::string("random") : opt.scriptPath) << "\n"
+              << "level:         " << (opt.levelPath.empty() ? "default" : opt.levelPath) << "\n"
+              << "traffic/world: " << opt.traffic << "\n"
+              << "max step:      " << (opt.maxStep > 0.f ? std::to_string(opt.maxStep) + " m" : std::string("off")) << "\n"
+              << "wall time:     " << seconds << " s\n"
+              << "steps/second:  " << (seconds > 0.0 ? double(totalSteps) / seconds : 0.0) << "\n"
+              << "pickups:       " << pickups << "\n"
+              << "gates opened:  " << gates << "\n"
+              << "portal hits:   " << portals << "\n"
+              << "checksum:      " << checksum << "\n";
+
+    if (recording && opt.worlds > 0) {
+        std::string error;
+        if (!recorder.save(opt.recordPath, &error)) {
+            std::cerr << "Failed to save recording: " << error << "\n";
+            return 1;
+        }
+        std::cout << "recorded:      " << recorder.tickCount() << " ticks of world 0 to " << opt.recordPath << "\n";
+    }
+
+    if (!opt.replayPath.empty()) {
+        std::cout << "replay:        " << (opt.worlds - mismatches) << "/" << opt.worlds << " match\n";
+        if (mismatches > 0) return 1;
+    }
+
+    return 0;
+}
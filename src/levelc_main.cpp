@@ -0,0 +1,72 @@
+#include "Level.hpp"
+#include "LevelGenerator.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// -----------------------------------------------------
+// Level compiler: text level -> binary level
+//
+//   bilsim_levelc <input.level> <output.blvl>
+//   bilsim_levelc --generate <colliders> <seed> <output.blvl>
+//
+// The binary file can be passed to the game and bilsim_headless with
+// --level; it is memory-mapped instead of parsed. --generate writes a
+// procedural stress level instead (stressLevelParams in LevelGenerator.hpp).
+// -----------------------------------------------------
+
+int main(int argc, char** argv) {
+
+    const bool generate = argc == 5 && std::string(argv[1]) == "--generate";
+    if (argc != 3 && !generate) {
+        std::cerr << "Usage: bilsim_levelc <input.level> <output.blvl>\n"
+                     "       bilsim_levelc --generate <colliders> <seed> <output.blvl>\n";
+        return 1;
+    }
+
+    std::vector<std::byte> bytes;
+    std::string error;
+
+    if (generate) {
+        const auto params = stressLevelParams(std::strtoull(argv[2], nullptr, 10),
+                                              std::uint32_t(std::strtoul(argv[3], nullptr, 10)));
+        if (!generateLevel(params, bytes, &error)) {
+            std::cerr << "--generate: " << error << "\n";
+            return 1;
+        }
+    } else {
+        std::ifstream in(argv[1], std::ios::binary);
+        if (!in) {
+            std::cerr << "Cannot open " << argv[1] << "\n";
+            return 1;
+        }
+
+        std::ostringstream text;
+        text << in.rdbuf();
+
+        if (!compileLevel(text.str(), bytes, &error)) {
+            std::cerr << argv[1] << ": " << error << "\n";
+            return 1;
+        }
+    }
+
+    const char* outPath = generate ? argv[4] : argv[2];
+    std::ofstream out(outPath, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+        std::cerr << "Cannot write " << outPath << "\n";
+        return 1;
+    }
+
+    LevelView level;
+    LevelView::parse(bytes, level);
+    std::cout << outPath << ": " << level.entities().size() << " entities, "
+              << level.header().gateCount << " gates, "
+              << level.triggers().size() << " triggers, " << bytes.size() << " bytes\n";
+    return 0;
+}
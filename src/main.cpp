@@ -2,11 +2,28 @@
 #include <threepp/loaders/OBJLoader.hpp>
 #include "Game.hpp"
 #include "Pickup.hpp"
-#include "Obstacle.hpp"
+#include "Level.hpp"
+#include "MeshCache.hpp"
+#include "AssetLoader.hpp"
+#include "InstancedBatch.hpp"
+#include "LodPolicy.hpp"
+#include "InputRecording.hpp"
+#include "Profiler.hpp"
+#include "SimThread.hpp"
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
 
 using namespace threepp;
 
@@ -15,13 +32,44 @@ using namespace threepp;
 // -----------------------------------------------------
 
 struct DoorSet {
-    std::shared_ptr<Mesh> left;
-    std::shared_ptr<Mesh> right;
-    float baseL{};
-    float baseR{};
+    std::size_t left = InstancedBatch::NoInstance;  // panels in the door batch
+    std::size_t right = InstancedBatch::NoInstance;
+    Vector3 baseL;             // closed positions
+    Vector3 baseR;
     float openAmount{0.f};
-    float doorZ{};
     bool vertical = false;
+    bool open = false;         // from the published frame's gate flags
+};
+
+// Car transform as drawn; interpolated between two simulation steps
+struct CarPose {
+    float x{};
+    float z{};
+    float rotation{};
+    float scale{1.f};
+
+    static CarPose from(const SimCarState& car) {
+        return {car.x, car.z, car.rotation, car.scale};
+    }
+
+    static CarPose lerp(const CarPose& a, const CarPose& b, float t) {
+        return {a.x + (b.x - a.x) * t,
+                a.z + (b.z - a.z) * t,
+                a.rotation + (b.rotation - a.rotation) * t,
+                a.scale + (b.scale - a.scale) * t};
+    }
+
+    bool operator==(const CarPose&) const = default;
+};
+
+// Scene nodes (and batch instances) written by the render sync; the sync
+// skips everything that did not change, so a parked car costs nothing
+struct SyncStats {
+    std::size_t lastFrame = 0;     // nodes written by the last frame
+    std::size_t nodes = 0;         // since the last report
+    std::size_t frames = 0;
+    bool print = false;            // toggled with I, reported once per second
+    std::chrono::steady_clock::time_point lastReport = std::chrono::steady_clock::now();
 };
 
 // -----------------------------------------------------
@@ -30,104 +78,149 @@ struct DoorSet {
 
 class KeyHandler : public KeyListener {
 public:
-    InputState& input;
-    Game& game;
-    std::vector<std::shared_ptr<Mesh>>& objectMeshes;
-    DoorSet& gate1;
-    DoorSet& gate2;
-    DoorSet& gate3;
-    bool& portalTriggered;
-    std::shared_ptr<Mesh> endScreen;
-
-
-    KeyHandler(InputState& i,
-               Game& g,
-               std::vector<std::shared_ptr<Mesh>>& meshes,
-               DoorSet& g1,
-               DoorSet& g2,
-               DoorSet& g3,
-               bool& portalFlag,
-               std::shared_ptr<Mesh> endScreenMesh)
-
-            : input(i),
-              game(g),
-              objectMeshes(meshes),
-              gate1(g1),
-              gate2(g2),
-              gate3(g3),
-              portalTriggered(portalFlag),
-              endScreen(endScreenMesh) {}
-
-    void onKeyPressed(KeyEvent evt) override {
-        switch (evt.key) {
-            case Key::W: input.accelerate = true; break;
-            case Key::S: input.brake      = true; break;
-            case Key::A: input.turnLeft   = true; break;
-            case Key::D: input.turnRight  = true; break;
-
-            case Key::R: {
-                // Reset world logic
-                game.reset();
-
-                // Reset doors
-                gate1.openAmount = gate2.openAmount = gate3.openAmount = 0.f;
-
-                auto resetGate = [&](DoorSet& g) {
-                    if (!g.vertical) {
-                        // horizontal gate resets on X
-                        g.left->position.x  = g.baseL;
-                        g.right->position.x = g.baseR;
-                    } else {
-                        // vertical gate resets on Z
-                        g.left->position.z  = g.baseL;
-                        g.right->position.z = g.baseR;
-                    }
-                };
-                endScreen->visible = false;
-
-
-                resetGate(gate1);
-                resetGate(gate2);
-                resetGate(gate3);
+    InputState input;          // the keys held right now
+    SimThread& sim;
+    SyncStats& syncStats;
 
 
-                // Reset portal state
-                portalTriggered = false;
+    KeyHandler(SimThread& simulation, SyncStats& stats)
+            : sim(simulation),
+              syncStats(stats) {}
 
-                // Reset pickup mesh visibility
-                const auto& objs = game.world().objects();
-                for (std::size_t i = 0; i < objs.size() && i < objectMeshes.size(); ++i) {
-                    auto pickup = dynamic_cast<Pickup*>(objs[i].get());
-                    if (pickup && objectMeshes[i]) {
-                        objectMeshes[i]->visible = true;
-                    }
+    void onKeyPressed(KeyEvent evt) override {
+        switch (evt.key) {
+            case Key::W: setKey(input.accelerate, true); break;
+            case Key::S: setKey(input.brake,      true); break;
+            case Key::A: setKey(input.turnLeft,   true); break;
+            case Key::D: setKey(input.turnRight,  true); break;
+
+            case Key::P: {
+                // Chrome trace of the last frames (chrome://tracing, ui.perfetto.dev)
+                if (Profiler::compiledIn() && Profiler::writeChromeTrace("bilsim_trace.json")) {
+                    std::cout << "Profile written to bilsim_trace.json" << std::endl;
                 }
-
                 break;
             }
 
+            case Key::I:
+                syncStats.print = !syncStats.print;
+                break;
+
+            case Key::R:
+                // World, doors, pickups and portal are reset on the simulation
+                // thread; the render loop follows the next published frame
+                sim.reset();
+                break;
+
             default: break;
         }
     }
 
     void onKeyReleased(KeyEvent evt) override {
         switch (evt.key) {
-            case Key::W: input.accelerate = false; break;
-            case Key::S: input.brake      = false; break;
-            case Key::A: input.turnLeft   = false; break;
-            case Key::D: input.turnRight  = false; break;
+            case Key::W: setKey(input.accelerate, false); break;
+            case Key::S: setKey(input.brake,      false); break;
+            case Key::A: setKey(input.turnLeft,   false); break;
+            case Key::D: setKey(input.turnRight,  false); break;
             default: break;
         }
     }
+
+private:
+    // key repeat sends presses for held keys: only changes go to the queue
+    void setKey(bool& key, bool down) {
+        if (key == down) return;
+        key = down;
+        sim.setInput(input);
+    }
+};
+
+
+// -----------------------------------------------------
+// MODELS (binary mesh cache -> threepp)
+// -----------------------------------------------------
+
+// Textures shared between models, decoded once. Used from the loader
+// threads; decoding is serialized because stb_image's flip flag is global.
+struct TextureCache {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Texture>> textures;
+
+    std::shared_ptr<Texture> get(const std::string& path) {
+        std::lock_guard lock(mutex);
+        auto& texture = textures[path];
+        if (!texture) texture = TextureLoader().load(path);
+        return texture;
+    }
 };
 
+// One Mesh with a material group per usemtl block. The cached arrays are
+// copied into the attributes as they are; only the GL upload is left, and
+// that happens on the render thread when the model is first drawn.
+std::shared_ptr<Group> makeModel(const MeshView& mesh, TextureCache& textures) {
+    auto geometry = BufferGeometry::create();
+    auto floats = [](std::span<const float> s) { return std::vector<float>(s.begin(), s.end()); };
+
+    geometry->setAttribute("position", FloatBufferAttribute::create(floats(mesh.positions()), 3));
+    if (!mesh.uvs().empty()) geometry->setAttribute("uv", FloatBufferAttribute::create(floats(mesh.uvs()), 2));
+    geometry->setIndex(std::vector<unsigned int>(mesh.indices().begin(), mesh.indices().end()));
+    if (!mesh.normals().empty()) {
+        geometry->setAttribute("normal", FloatBufferAttribute::create(floats(mesh.normals()), 3));
+    } else {
+        geometry->computeVertexNormals();
+    }
+
+    std::vector<std::shared_ptr<Material>> materials;
+    for (std::size_t i = 0; i < mesh.materialCount(); ++i) {
+        auto material = MeshPhongMaterial::create();
+        material->name = std::string(mesh.materialName(i));
+        const float* kd = mesh.materialDiffuse(i);
+        material->color.setRGB(kd[0], kd[1], kd[2]);
+
+        // the models share one color map: decode it once
+        const std::string map(mesh.materialMap(i));
+        if (!map.empty()) material->map = textures.get(map);
+        materials.push_back(material);
+    }
+
+    for (const auto& g : mesh.groups()) {
+        geometry->addGroup(static_cast<int>(g.start), static_cast<int>(g.count), g.material);
+    }
+
+    auto root = Group::create();
+    root->add(Mesh::create(geometry, materials));
+    return root;
+}
 
 
 // -----------------------------------------------------
 // MAIN
 // -----------------------------------------------------
 
-int main() {
+int main(int argc, char** argv) {
+
+    // --- Simulation rate (independent of the display rate) and level ---
+    double simHz = 60.0;
+    std::string levelPath;
+    std::string recordPath;   // --record FILE: write the input stream for bilsim_headless --replay
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--sim-hz") simHz = std::max(1.0, std::atof(argv[++i]));
+        else if (arg == "--level") levelPath = argv[++i];
+        else if (arg == "--record") recordPath = argv[++i];
+    }
+
+    // Colliders (World) and fences/doors (below) both come from this level
+    LevelFile levelFile;
+    const LevelView* level = &LevelFile::defaultLevel().view();
+    if (!levelPath.empty()) {
+        std::string error;
+        if (!levelFile.open(levelPath, &error)) {
+            std::cerr << "Failed to load level " << levelPath << ": " << error << "\n";
+            return 1;
+        }
+        level = &levelFile.view();
+    }
 
     // --- Window / renderer ---
     Canvas::Parameters params;
@@ -172,14 +265,27 @@ int main() {
     auto ambient = AmbientLight::create(0xffffff, 0.5f);
     scene.add(ambient);
 
-    // --- Ground plane (400x400) with stone path texture ---
-    auto texture = TextureLoader().load("objmodels/textures/stonepath.png");
-    texture->wrapS = TextureWrapping::Repeat;
-    texture->wrapT = TextureWrapping::Repeat;
-    texture->repeat.set(8, 8);   // repeats the pattern
+    // --- Asset loading ---
+    // Models and textures are read and decoded on these threads while the
+    // game already runs; the animate loop puts them into the scene as they
+    // arrive (AssetLoader::poll), so all scene and GL work stays on this thread.
+    TextureCache textureCache;
+    AssetLoader assets(std::clamp(std::thread::hardware_concurrency(), 2u, 4u));
+
+    auto loadTexture = [&](const std::string& path, std::function<void(std::shared_ptr<Texture>)> done) {
+        assets.load<std::shared_ptr<Texture>>([&textureCache, path] { return textureCache.get(path); },
+                                              std::move(done));
+    };
 
-    auto groundMat = MeshPhongMaterial::create({
-        {"map", texture}
+    // --- Ground plane (400x400) with stone path texture ---
+    auto groundMat = MeshPhongMaterial::create();
+
+    loadTexture("objmodels/textures/stonepath.png", [groundMat](std::shared_ptr<Texture> texture) {
+        texture->wrapS = TextureWrapping::Repeat;
+        texture->wrapT = TextureWrapping::Repeat;
+        texture->repeat.set(8, 8);   // repeats the pattern
+        groundMat->map = texture;
+        groundMat->needsUpdate();
     });
 
     auto ground = Mesh::create(
@@ -248,87 +354,67 @@ int main() {
     float steeringAngle = 0.f;
     const float steeringLerp = 0.25f;
 
-    auto fenceMat = MeshPhongMaterial::create({{"color", 0x553311}});
-
-    auto makeFence = [&](float x, float z, float w, float h) {
-        auto mesh = Mesh::create(BoxGeometry::create(w, 2.f, h), fenceMat);
-        mesh->position.set(x, 1.f, z);
-        return mesh;
-    };
+    // =====================================================
+    //      FENCES, DOORS, PICKUPS: ONE INSTANCED BATCH EACH
+    // =====================================================
+    // Shared geometry: unit shapes, sized per instance
+    auto unitBox = BoxGeometry::create(1.f, 1.f, 1.f);
+    auto pickupSphere = SphereGeometry::create(0.8f, 16, 16);
 
-    // Village fence
-    scene.add(makeFence(-120.f, -158.f, 1.f, 55.f)); // south
-    scene.add(makeFence(-120.f, -92.f, 1.f, 55.f));  // north
-    scene.add(makeFence(-160.f, -185.f, 80.f, 1.f));  // west
-    scene.add(makeFence(-160.f,  -65.f, 80.f, 1.f));  // east
+    auto fenceMat = MeshPhongMaterial::create({{"color", 0x553311}});
+    auto doorMat = MeshPhongMaterial::create({{"color", 0x8B4513}});
+    auto pickupMat = MeshPhongMaterial::create({{"color", 0x00ff00}});
 
-    // Castle fence
-    scene.add(makeFence(27.f, 100.f, 45.f, 1.f)); // north fence left
-    scene.add(makeFence(-20.f, 100.f, 30.f, 1.f));  // north fence right
-    scene.add(makeFence(50.f,150.f,1.f,100.f));    // west
-    scene.add(makeFence(-35.f, 150.f,1.f,100.f));    // east
+    InstancedBatch fenceBatch(unitBox, fenceMat);
+    InstancedBatch doorBatch(unitBox, doorMat);
+    InstancedBatch pickupBatch(pickupSphere, pickupMat);
 
-    // Smelter fence
+    auto addBatch = [&](InstancedBatch& batch) {
+        if (auto mesh = batch.build()) scene.add(mesh);
+    };
 
-    scene.add(makeFence(110.f, -110.f, 1.f, 9.f)); // north
-    scene.add(makeFence(110.f, -160.f, 1.f, 70.f)); // south
-    scene.add(makeFence(155.f, -105.f,90.f,1.f));    // west
-    scene.add(makeFence(155.f,-195.f,90.f,1.f));      // east
+    // Fences from the level (same boxes as the colliders in World)
+    for (const auto& e : level->entities()) {
+        if (e.kind == LevelEntityKind::Fence) {
+            fenceBatch.add({e.x, 1.f, e.z}, {2.f * e.halfW, 2.f, 2.f * e.halfL});
+        }
+    }
+    addBatch(fenceBatch);
 
 
 
     // =====================================================
-    //               DOORS: THREE DOUBLE GATES
+    //               DOORS: ONE DOUBLE GATE PER LEVEL GATE
     // =====================================================
 
-    auto doorMat = MeshPhongMaterial::create({{"color", 0x8B4513}});
-
     auto makeDoor = [&](float x, float z, bool vertical) {
         DoorSet d;
 
         // Each door panel
-        float doorWidth  = 5.f;
-        float doorHeight = 7.f;
-        float doorDepth  = 0.5f;
-
-        d.left  = Mesh::create(BoxGeometry::create(doorWidth, doorHeight, doorDepth), doorMat);
-        d.right = Mesh::create(BoxGeometry::create(doorWidth, doorHeight, doorDepth), doorMat);
+        const Vector3 panel(5.f, 7.f, 0.5f); // width, height, depth
 
         // Save gate orientation
         d.vertical = vertical;
 
-
-
-
         if (!vertical) {
             // --------------------------------------------------
             // HORIZONTAL GATE
             // (castle gate: sliding left/right on X axis)
             // --------------------------------------------------
-            d.left->position.set(x - 3.f, 2.f, z);
-            d.right->position.set(x + 3.f, 2.f, z);
-
-            d.baseL = d.left->position.x;
-            d.baseR = d.right->position.x;
+            d.baseL.set(x - 3.f, 2.f, z);
+            d.baseR.set(x + 3.f, 2.f, z);
         } else {
             // --------------------------------------------------
             // VERTICAL GATE
             // (village + smelter: sliding forward/back on Z axis)
             // --------------------------------------------------
-            d.left->position.set(x, 2.f, z - 3.f);
-            d.right->position.set(x, 2.f, z + 3.f);
-
-            d.baseL = d.left->position.z;
-            d.baseR = d.right->position.z;
-
-            d.left->rotation.y  = math::PI / 2;
-            d.right->rotation.y = math::PI / 2;
+            d.baseL.set(x, 2.f, z - 3.f);
+            d.baseR.set(x, 2.f, z + 3.f);
         }
 
-        d.doorZ = z;
-
-        scene.add(d.left);
-        scene.add(d.right);
+        const float rotation = vertical ? math::PI / 2 : 0.f;
+        d.left  = doorBatch.add(d.baseL, panel, rotation);
+        d.right = doorBatch.add(d.baseR, panel, rotation);
 
         return d;
     };
@@ -336,10 +422,14 @@ int main() {
 
 
 
-    // align with World.cpp gates
-    DoorSet gate1 = makeDoor(-120.f, -125.f, true);   // village = vertical
-    DoorSet gate2 = makeDoor(   0.f,  100.f, false);  // castle = horizontal
-    DoorSet gate3 = makeDoor( 110.f, -120.f, true);   // smelter = vertical
+    // doors[n - 1] belongs to gate n; they slide along the gate's long side
+    std::vector<DoorSet> doors(level->header().gateCount);
+    for (const auto& e : level->entities()) {
+        if (e.kind == LevelEntityKind::Gate) {
+            doors[e.gate - 1] = makeDoor(e.x, e.z, e.halfL > e.halfW);
+        }
+    }
+    addBatch(doorBatch);
 
     auto portalMat = MeshPhongMaterial::create({
     {"color", 0x00ccff}
@@ -355,7 +445,9 @@ int main() {
 
     // Make it vertical
     portalMesh->rotation.y = math::PI / 2;
-    portalMesh->position.set(-150.f, 0.f, 120.f);
+    const auto& levelHeader = level->header();
+    portalMesh->position.set(levelHeader.portalX, 0.f, levelHeader.portalZ);
+    portalMesh->visible = levelHeader.portalHalfW > 0.f;
     scene.add(portalMesh);
 
 
@@ -364,10 +456,14 @@ int main() {
     // End screen when hit hidden portal
     // ------------------------------------
 
-    auto endTexture = TextureLoader().load("objmodels/textures/cloud_sky.png");
-    auto endMat = MeshBasicMaterial::create({{"map", endTexture}});
+    auto endMat = MeshBasicMaterial::create();
     endMat->transparent = true;
 
+    loadTexture("objmodels/textures/cloud_sky.png", [endMat](std::shared_ptr<Texture> texture) {
+        endMat->map = texture;
+        endMat->needsUpdate();
+    });
+
     auto endScreen = Mesh::create(
         PlaneGeometry::create(200, 120),   // big enough to fill view
         endMat
@@ -391,224 +487,418 @@ int main() {
     // =====================================================
     //                 GAME LOGIC
     // =====================================================
-    Game game;
-    InputState input;
+    Game game(*level);
 
-    // Visual meshes for pickups
-    std::vector<std::shared_ptr<Mesh>> objectMeshes;
-    objectMeshes.reserve(game.world().objects().size());
+    // Pickup instances, indexed like World::objects() (obstacles are pure
+    // colliders and have none)
+    std::vector<std::size_t> pickupInstance;
+    pickupInstance.reserve(game.world().objects().size());
 
     for (const auto& obj : game.world().objects()) {
-
-        auto pickup   = dynamic_cast<Pickup*>(obj.get());
-        auto obstacle = dynamic_cast<Obstacle*>(obj.get());
-
-        if (pickup) {
-            auto mesh = Mesh::create(
-                    SphereGeometry::create(0.8f, 16, 16),
-                    MeshPhongMaterial::create({{"color", 0x00ff00}})
-            );
+        if (auto pickup = dynamic_cast<Pickup*>(obj.get())) {
             auto b = pickup->bounds();
-            mesh->position.set(
-                    (b.minX + b.maxX) * 0.5f,
-                    0.8f,
-                    (b.minZ + b.maxZ) * 0.5f
-            );
-            scene.add(mesh);
-            objectMeshes.push_back(mesh);
-
-        } else if (obstacle) {
-            // no visible mesh for obstacles here (pure colliders)
-            objectMeshes.push_back(nullptr);
+            pickupInstance.push_back(pickupBatch.add(
+                    {(b.minX + b.maxX) * 0.5f, 0.8f, (b.minZ + b.maxZ) * 0.5f},
+                    {1.f, 1.f, 1.f}));
         } else {
-            objectMeshes.push_back(nullptr);
+            pickupInstance.push_back(InstancedBatch::NoInstance);
         }
     }
+    addBatch(pickupBatch);
 
     // =====================================================
     //                 LOAD OBJ MODELS
     // =====================================================
-    auto loadModel = [&](const std::string& name) -> std::shared_ptr<Group> {
+    // Served from objmodels/cache/ after the first start (see MeshCache.hpp),
+    // together with MeshLodLevels simplified versions; OBJLoader stays as the
+    // fallback (full detail only) if the model cannot be read that way.
+    // Runs on the loader threads.
+    struct BuildingModel {
+        std::array<std::shared_ptr<Group>, MeshLodLevels> lods; // missing levels reuse a finer one
+        Vector3 center;        // bounding sphere in model space
+        float radius = 0.f;
+    };
+
+    auto loadModel = [&textureCache](const std::string& name) -> BuildingModel {
         std::string objPath = "objmodels/" + name + ".obj";
-        OBJLoader loader;
-        auto root = loader.load(objPath);
-        if (!root) {
-            std::cerr << "Failed to load: " << objPath << "\n";
-            return nullptr;
+        BuildingModel model;
+
+        for (int lod = 0; lod < MeshLodLevels; ++lod) {
+            MeshFile mesh;
+            std::string error;
+            if (!mesh.open(objPath, "objmodels/cache", lod, &error)) {
+                if (lod == 0) std::cerr << "Mesh cache: " << error << ", using OBJLoader\n";
+                break;
+            }
+            model.lods[lod] = makeModel(mesh.view(), textureCache);
+
+            if (lod == 0) {
+                const auto p = mesh.view().positions();
+                Vector3 lo(p[0], p[1], p[2]), hi = lo;
+                for (std::size_t i = 0; i + 2 < p.size(); i += 3) {
+                    lo.set(std::min(lo.x, p[i]), std::min(lo.y, p[i + 1]), std::min(lo.z, p[i + 2]));
+                    hi.set(std::max(hi.x, p[i]), std::max(hi.y, p[i + 1]), std::max(hi.z, p[i + 2]));
+                }
+                model.center.set((lo.x + hi.x) * 0.5f, (lo.y + hi.y) * 0.5f, (lo.z + hi.z) * 0.5f);
+                model.radius = hi.distanceTo(lo) * 0.5f;
+            }
         }
-        root->scale.set(4.f, 4.f, 4.f);
-        return root;
-    };
 
-    auto mountainModel = loadModel("stone-mountain");
-    auto villageModel  = loadModel("building-village");
-    auto castleModel   = loadModel("building-castle");
-    auto archeryModel  = loadModel("building-archery");
-    auto smelterModel  = loadModel("building-smelter");
+        if (!model.lods[0]) {
+            // OBJLoader decodes the MTL textures itself: same lock as the cache
+            std::shared_ptr<Group> root;
+            {
+                std::lock_guard lock(textureCache.mutex);
+                root = OBJLoader().load(objPath);
+            }
+            if (!root) {
+                std::cerr << "Failed to load: " << objPath << "\n";
+                return model;
+            }
+            Box3 box;
+            box.setFromObject(*root);
+            model.center.set((box.min.x + box.max.x) * 0.5f, (box.min.y + box.max.y) * 0.5f,
+                             (box.min.z + box.max.z) * 0.5f);
+            model.radius = box.max.distanceTo(box.min) * 0.5f;
+            model.lods[0] = root;
+        }
+
+        for (int lod = 1; lod < MeshLodLevels; ++lod) {
+            if (!model.lods[lod]) model.lods[lod] = model.lods[lod - 1];
+        }
+        return model;
+    };
 
     struct BuildingPlacement {
-        std::shared_ptr<Group> model;
+        std::string model;
         Vector3 position;
         Vector3 scale;
         Vector3 rotation;
     };
 
     std::vector<BuildingPlacement> placements = {
-            {villageModel,  {-150.f, -11.f, -150.f}, {60.f, 60.f, 60.f},{0,180,0}},
-            {villageModel,  {-150.f, -11.f, -100.f}, {60.f, 60.f, 60.f},{0,180,0}},
-            {mountainModel, {-180.f, -14.f,  100.f}, {150.f,150.f,150.f}},
-            {castleModel,   {   5.f, -15.f, 150.f},  {80.f, 80.f, 80.f},{0,-90,0}},
-            {archeryModel,  { 150.f,  -13.f, 150.f},  {60.f, 60.f, 60.f}},
-            {smelterModel,  { 150.f, -15.f,-150.f},  {80.f, 80.f, 80.f}},
+            {"building-village",  {-150.f, -11.f, -150.f}, {60.f, 60.f, 60.f},{0,180,0}},
+            {"building-village",  {-150.f, -11.f, -100.f}, {60.f, 60.f, 60.f},{0,180,0}},
+            {"stone-mountain",    {-180.f, -14.f,  100.f}, {150.f,150.f,150.f}},
+            {"building-castle",   {   5.f, -15.f, 150.f},  {80.f, 80.f, 80.f},{0,-90,0}},
+            {"building-archery",  { 150.f,  -13.f, 150.f},  {60.f, 60.f, 60.f}},
+            {"building-smelter",  { 150.f, -15.f,-150.f},  {80.f, 80.f, 80.f}},
+    };
+
+    // A placed model: one child per detail level, at most one of them visible
+    struct Building {
+        std::shared_ptr<Group> root;
+        std::array<std::shared_ptr<Object3D>, MeshLodLevels> lods;
+        Sphere bounds;          // world space
+        int level = 0;
     };
+    std::vector<Building> buildings;
 
-    for (auto& bp : placements) {
-        if (!bp.model) continue;
-        auto obj = bp.model->clone();
-        obj->position.copy(bp.position);
-        obj->scale.copy(bp.scale);
-        obj->rotation.set(
-            threepp::math::degToRad(bp.rotation.x),
-            threepp::math::degToRad(bp.rotation.y),
-            threepp::math::degToRad(bp.rotation.z)
-
-            );
-        scene.add(obj);
+    // every model once, placed wherever it is used as soon as it arrives
+    std::vector<std::string> modelNames;
+    for (const auto& bp : placements) {
+        if (std::find(modelNames.begin(), modelNames.end(), bp.model) == modelNames.end()) {
+            modelNames.push_back(bp.model);
+        }
+    }
+
+    for (const auto& name : modelNames) {
+        assets.load<BuildingModel>(
+                [loadModel, name] { return loadModel(name); },
+                [&placements, &buildings, &scene, name](BuildingModel model) {
+                    if (!model.lods[0]) return;
+                    for (const auto& bp : placements) {
+                        if (bp.model != name) continue;
+
+                        Building b;
+                        b.root = Group::create();
+                        b.root->position.copy(bp.position);
+                        b.root->scale.copy(bp.scale);
+                        b.root->rotation.set(
+                            threepp::math::degToRad(bp.rotation.x),
+                            threepp::math::degToRad(bp.rotation.y),
+                            threepp::math::degToRad(bp.rotation.z)
+
+                            );
+                        for (int lod = 0; lod < MeshLodLevels; ++lod) {
+                            b.lods[lod] = model.lods[lod]->clone();
+                            b.lods[lod]->visible = lod == 0;
+                            b.root->add(b.lods[lod]);
+                        }
+
+                        b.root->updateMatrixWorld(true);
+                        b.bounds.center.copy(model.center).applyMatrix4(b.root->matrixWorld);
+                        b.bounds.radius = model.radius * std::max({bp.scale.x, bp.scale.y, bp.scale.z});
+
+                        scene.add(b.root);
+                        buildings.push_back(b);
+                    }
+                });
     }
 
+    // Full detail up close, then the simplified meshes; past the last
+    // distance (or outside the view) a building is not drawn at all.
+    // Distances are to the bounding sphere, not the model's origin.
+    const LodPolicy buildingLod({120.f, 300.f, 900.f}, 10.f);
+
     // =====================================================
-    //                 PORTAL STATE
+    //                 INPUT RECORDING
     // =====================================================
-    bool portalTriggered = false;
+    InputRecording recording;
+    const bool recordInput = !recordPath.empty();
+
+    // =====================================================
+    //                 SIMULATION THREAD
+    // =====================================================
+    // The game runs in fixed steps of 1/simHz seconds on its own thread.
+    // Input goes to it through a queue; after each batch of steps it
+    // publishes the car, gate, pickup and portal state, and this thread
+    // draws the newest one without waiting (see SimThread.hpp). From
+    // sim.start() to sim.stop() only the simulation thread touches game
+    // and recording.
+    SimThread sim(game, 1.0 / simHz, recordInput ? &recording : nullptr);
+
+    if (recordInput) recording.begin(sim.step(), level->hash());
 
     // =====================================================
     //                 INPUT HANDLER
     // =====================================================
-    KeyHandler handler(input,
-                       game,
-                       objectMeshes,
-                       gate1,
-                       gate2,
-                       gate3,
-                       portalTriggered,
-                       endScreen);
+    SyncStats syncStats;
+
+    KeyHandler handler(sim, syncStats);
 
     canvas.addKeyListener(handler);
 
     // =====================================================
     //                 MAIN LOOP
     // =====================================================
-    canvas.animate([&]() {
+    // Meshes are drawn between the last two simulated states of the newest
+    // frame, so display rate and simulation rate are independent.
+    auto lastFrame = std::chrono::steady_clock::now();
+
+    // what the scene shows right now; the sync only writes what differs
+    CarPose drawnPose = CarPose::from(sim.frame().car);
+    float drawnSteer = 0.f;
+    std::uint32_t drawnChanges = sim.frame().changes;
+    std::uint32_t drawnResets = sim.frame().resets;
+    bool portalTriggered = false;
 
-        float dt = 1.f / 60.f;
+    float openDist = 6.f;         // how far doors slide apart
 
-        auto& world = game.world();
+    // door animation advances per frame, towards the published gate state
+    auto stepGate = [&](DoorSet& gate, float seconds) {
+        float openSpeed = std::min(1.f, seconds * 1.5f);   // nice smooth opening
 
-        // game update only if not in portal end-state
-        if (!portalTriggered) {
-            game.update(dt, input);
+        // Smooth approach: openAmount approaches 1 if open, 0 if closed
+        float target = gate.open ? 1.f : 0.f;
+        gate.openAmount += (target - gate.openAmount) * openSpeed;
+        // settle instead of creeping forever, so a finished door stops moving
+        if (std::abs(target - gate.openAmount) < 1e-3f) gate.openAmount = target;
+    };
+
+    auto placeGate = [&](DoorSet& gate) {
+        if (gate.left == InstancedBatch::NoInstance) return; // gate number without doors in the level
+        float open = gate.openAmount;
+
+        Vector3 left = gate.baseL;
+        Vector3 right = gate.baseR;
+        if (!gate.vertical) {
+            // Horizontal door (slides on X)
+            left.x  -= open * openDist;
+            right.x += open * openDist;
+        } else {
+            // Vertical door (slides on Z)
+            left.z  -= open * openDist;
+            right.z += open * openDist;
         }
+        doorBatch.setPosition(gate.left, left);
+        doorBatch.setPosition(gate.right, right);
+    };
 
-        const auto& car = world.car();
+    // Pickups, gates and portal as in the frame; only called when its
+    // change counter moved
+    auto applyFrame = [&](const SimFrame& frame) {
+        for (std::size_t i = 0; i < pickupInstance.size(); ++i) {
+            if (pickupInstance[i] == InstancedBatch::NoInstance) continue;
+            const bool active = i / 64 < frame.active.size() && (frame.active[i / 64] >> (i % 64)) & 1u;
+            pickupBatch.setVisible(pickupInstance[i], active);
+        }
 
-        // --- Sync car mesh ---
-        carMesh->position.x = car.position().x;
-        carMesh->position.z = car.position().z;
-        carMesh->rotation.y = car.rotation();
+        for (std::size_t g = 0; g < doors.size(); ++g) {
+            doors[g].open = g < frame.gateOpen.size() && frame.gateOpen[g];
+        }
 
-        float s = car.getVisualScale();
-        carMesh->scale.set(s, s, s);
+        if (frame.portalTriggered && !portalTriggered) {
+            // Print end message to console (always works)
+            std::cout << "The end, thanks for playing (OOP Project)" << std::endl;
+        }
+        portalTriggered = frame.portalTriggered;
+        endScreen->visible = portalTriggered;
+    };
+
+    Profiler::setThreadName("main");
+    sim.start();
+
+    canvas.animate([&]() {
+        BILSIM_PROFILE_SCOPE("frame");
+
+        // one finished asset per frame, so first-draw GL uploads are spread out
+        if (!assets.idle()) {
+            BILSIM_PROFILE_SCOPE("assets");
+            assets.poll(1);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        double frameSeconds = std::chrono::duration<double>(now - lastFrame).count();
+        lastFrame = now;
+
+        sim.fetch();
+        const SimFrame& frame = sim.frame();
+
+        if (frame.resets != drawnResets) {
+            // doors close at once after a reset instead of sliding shut
+            for (auto& door : doors) door.openAmount = 0.f;
+            drawnResets = frame.resets;
+        }
+        if (frame.changes != drawnChanges) {
+            applyFrame(frame);
+            drawnChanges = frame.changes;
+        }
+
+        // a reset publishes prevCar == car, so the car does not slide back
+        const CarPose pose = CarPose::lerp(CarPose::from(frame.prevCar), CarPose::from(frame.car), sim.alpha(now));
 
         // --- Steering (front wheels) ---
         float targetSteer = 0.f;
-        if (input.turnLeft)  targetSteer =  0.6f;
-        if (input.turnRight) targetSteer = -0.6f;
+        if (handler.input.turnLeft)  targetSteer =  0.6f;
+        if (handler.input.turnRight) targetSteer = -0.6f;
 
-        steeringAngle += (targetSteer - steeringAngle) * steeringLerp;
-        flSteer->rotation.y = steeringAngle;
-        frSteer->rotation.y = steeringAngle;
+        // steeringLerp is tuned per simulation step; scale it to the frame time
+        const float steerLerp = 1.f - std::pow(1.f - steeringLerp, static_cast<float>(frameSeconds / sim.step()));
+        steeringAngle += (targetSteer - steeringAngle) * steerLerp;
+        if (std::abs(targetSteer - steeringAngle) < 1e-3f) steeringAngle = targetSteer;
 
         // --- Wheel spin ---
-        float spin = car.speed() * dt * 7.f;
-        flWheel->rotation.x += spin;
-        frWheel->rotation.x += spin;
-        rlWheel->rotation.x += spin;
-        rrWheel->rotation.x += spin;
+        const float spin = portalTriggered ? 0.f : frame.car.speed * static_cast<float>(frameSeconds) * 7.f;
+        if (spin != 0.f) {
+            flWheel->rotation.x += spin;
+            frWheel->rotation.x += spin;
+            rlWheel->rotation.x += spin;
+            rrWheel->rotation.x += spin;
+        }
 
         //-----------------------------------------------------------
         // GATE DOOR OPENING SYNCHRONIZED WITH WORLD.CPP LOGIC
         //-----------------------------------------------------------
-        float openSpeed = dt * 1.5f;   // nice smooth opening
-        float openDist  = 6.f;         // how far doors slide apart
-
-        auto syncGate = [&](DoorSet& gate, bool worldGateIsOpen) {
-
-            // Smooth approach: openAmount approaches 1 if open, 0 if closed
-            float target = worldGateIsOpen ? 1.f : 0.f;
-            gate.openAmount += (target - gate.openAmount) * openSpeed;
+        {
+            BILSIM_PROFILE_SCOPE("door animation");
+            for (auto& door : doors) stepGate(door, static_cast<float>(frameSeconds));
+        }
 
-            if (!gate.vertical) {
-                // Horizontal door (slides on X)
-                gate.left->position.x  = gate.baseL - gate.openAmount * openDist;
-                gate.right->position.x = gate.baseR + gate.openAmount * openDist;
-            } else {
-                // Vertical door (slides on Z)
-                gate.left->position.z  = gate.baseL - gate.openAmount * openDist;
-                gate.right->position.z = gate.baseR + gate.openAmount * openDist;
+        // --- Sync car mesh (interpolated), doors and pickups: changes only ---
+        {
+            BILSIM_PROFILE_SCOPE("mesh sync");
+            std::size_t written = spin != 0.f ? 4 : 0;
+
+            if (pose != drawnPose) {
+                carMesh->position.x = pose.x;
+                carMesh->position.z = pose.z;
+                carMesh->rotation.y = pose.rotation;
+                carMesh->scale.set(pose.scale, pose.scale, pose.scale);
+                drawnPose = pose;
+                written++;
             }
-        };
-
-        // Sync with WORLD state:
-        syncGate(gate1, world.gate1IsOpen());
-        syncGate(gate2, world.gate2IsOpen());
-        syncGate(gate3, world.gate3IsOpen());
-
 
-        // --- Hide collected pickups ---
-        const auto& objs = world.objects();
-        for (size_t i = 0; i < objs.size() && i < objectMeshes.size(); ++i) {
-            auto pick = dynamic_cast<Pickup*>(objs[i].get());
-            if (pick && !pick->isActive() && objectMeshes[i]) {
-                objectMeshes[i]->visible = false;
+            if (steeringAngle != drawnSteer) {
+                flSteer->rotation.y = steeringAngle;
+                frSteer->rotation.y = steeringAngle;
+                drawnSteer = steeringAngle;
+                written += 2;
             }
-        }
-
-        // --- Portal trigger from world ---
-        if (world.portalTriggered()) {
-            if (!portalTriggered) {
-                portalTriggered = true;
-                endScreen->visible = true;
 
-                // Print end message to console (always works)
-                std::cout << "The end, thanks for playing (OOP Project)" << std::endl;
+            // a settled door lands on the same instance position, which the
+            // batch ignores
+            for (auto& door : doors) placeGate(door);
+            written += doorBatch.commit();
+            written += pickupBatch.commit();
+
+            syncStats.lastFrame = written;
+            syncStats.nodes += written;
+            syncStats.frames++;
+            if (syncStats.print && now - syncStats.lastReport >= std::chrono::seconds(1)) {
+                std::cout << "sync: " << double(syncStats.nodes) / double(syncStats.frames)
+                          << " nodes/frame (last frame " << syncStats.lastFrame << ")" << std::endl;
+                syncStats.nodes = syncStats.frames = 0;
+                syncStats.lastReport = now;
             }
         }
 
 
         // --- Camera: chase or god view ---
-        if (!portalTriggered) {
+        {
+            BILSIM_PROFILE_SCOPE("camera");
+            if (!portalTriggered) {
 
-            float fx = std::sin(car.rotation());
-            float fz = std::cos(car.rotation());
+                float fx = std::sin(pose.rotation);
+                float fz = std::cos(pose.rotation);
 
-            Vector3 desired(
-                    car.position().x - fx * camDistance,
-                    camHeight,
-                    car.position().z - fz * camDistance
-            );
+                Vector3 desired(
+                        pose.x - fx * camDistance,
+                        camHeight,
+                        pose.z - fz * camDistance
+                );
 
-            camera.position.lerp(desired, camSmooth);
-            camera.lookAt({car.position().x, 5.f, car.position().z});
+                // camSmooth is tuned per 1/60 s; scale it to the real frame time
+                float smooth = 1.f - std::pow(1.f - camSmooth, static_cast<float>(frameSeconds * 60.0));
+                camera.position.lerp(desired, smooth);
+                camera.lookAt({pose.x, 5.f, pose.z});
 
-        } else {
-            // God-view
-            camera.position.set(0.f, 350.f, 0.f);
-            camera.lookAt({0.f, 0.f, 30.f});
+            } else {
+                // God-view
+                camera.position.set(0.f, 350.f, 0.f);
+                camera.lookAt({0.f, 0.f, 30.f});
+            }
         }
 
 
+        // --- Building LOD + culling ---
+        {
+            BILSIM_PROFILE_SCOPE("lod");
+            camera.updateMatrixWorld();
+            Matrix4 viewProjection;
+            viewProjection.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse);
+            Frustum frustum;
+            frustum.setFromProjectionMatrix(viewProjection);
+
+            for (auto& b : buildings) {
+                const float distance = std::max(0.f, camera.position.distanceTo(b.bounds.center) - b.bounds.radius);
+                const int level = buildingLod.select(distance, b.level);
+                if (level != b.level) {
+                    for (int lod = 0; lod < MeshLodLevels; ++lod) b.lods[lod]->visible = lod == level;
+                    b.level = level;
+                }
+                b.root->visible = level != LodPolicy::Culled && frustum.intersectsSphere(b.bounds);
+            }
+        }
 
-
+        BILSIM_PROFILE_SCOPE("render");
         renderer.render(scene, camera);
     });
-}
\ No newline at end of file
+
+    sim.stop();
+
+    if (Profiler::compiledIn()) {
+        Profiler::writeChromeTrace("bilsim_trace.json");
+        std::cout << "Profile written to bilsim_trace.json" << std::endl;
+    }
+
+    if (recordInput) {
+        recording.finish(game.world());
+        std::string error;
+        if (recording.save(recordPath, &error)) {
+            std::cout << "Recorded " << recording.tickCount() << " ticks to " << recordPath << std::endl;
+        } else {
+            std::cerr << "Failed to save recording: " << error << std::endl;
+        }
+    }
+}
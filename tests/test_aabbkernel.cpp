@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+#include "AabbKernel.hpp"
+
+TEST_CASE("SIMD overlap mask matches the scalar path") {
+
+    std::mt19937 rng(7);
+    // coarse integer grid -> plenty of boxes that exactly touch the car
+    std::uniform_int_distribution<int> pos(-20, 20);
+    std::uniform_int_distribution<int> half(0, 6);
+
+    for (std::size_t count : {0u, 1u, 3u, 4u, 7u, 8u, 63u, 64u, 65u, 333u}) {
+        std::vector<float> minX, maxX, minZ, maxZ;
+        for (std::size_t i = 0; i < count; ++i) {
+            float x = float(pos(rng)), z = float(pos(rng));
+            float hw = float(half(rng)), hl = float(half(rng));
+            minX.push_back(x - hw);
+            maxX.push_back(x + hw);
+            minZ.push_back(z - hl);
+            maxZ.push_back(z + hl);
+        }
+
+        const std::size_t words = (count + 63) / 64 + 1;
+
+        for (int q = 0; q < 50; ++q) {
+            float x = float(pos(rng)), z = float(pos(rng));
+            Car::AABB car{x - 1.f, x + 1.f, z - 2.f, z + 2.f};
+
+            std::vector<std::uint64_t> simd(words, ~0ull), scalar(words, ~0ull);
+            aabbOverlapMask(car, minX.data(), maxX.data(), minZ.data(), maxZ.data(), count, simd.data());
+            aabbOverlapMaskScalar(car, minX.data(), maxX.data(), minZ.data(), maxZ.data(), count, scalar.data());
+
+            REQUIRE(simd == scalar);
+        }
+    }
+}
+
+TEST_CASE("Overlap mask flags touching boxes") {
+
+    float minX[] = {2.f, 2.1f, -5.f, -3.f, 0.f};
+    float maxX[] = {3.f, 3.f, -1.f, -2.f, 0.f};
+    float minZ[] = {0.f, 0.f, 2.f, 0.f, 0.f};
+    float maxZ[] = {1.f, 1.f, 3.f, 1.f, 0.f};
+
+    Car::AABB car{-1.f, 2.f, -2.f, 2.f};
+
+    std::uint64_t mask = 0;
+    aabbOverlapMask(car, minX, maxX, minZ, maxZ, 5, &mask);
+
+    // 0 touches on x, 1 is just outside, 2 touches on x and z,
+    // 3 is left of the car, 4 is a point inside
+    REQUIRE(mask == 0b10101u);
+}
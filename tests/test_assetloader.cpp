@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "AssetLoader.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+// polls until every requested asset was delivered (or a generous timeout)
+void drain(AssetLoader& loader) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!loader.idle() && std::chrono::steady_clock::now() < deadline) {
+        if (loader.poll() == 0) std::this_thread::yield();
+    }
+}
+
+}
+
+TEST_CASE("AssetLoader works in the background and delivers on the polling thread") {
+
+    AssetLoader loader(4);
+    const auto self = std::this_thread::get_id();
+
+    int delivered = 0;
+    int sum = 0;
+    bool onPollingThread = true;
+    for (int i = 1; i <= 20; ++i) {
+        loader.load<std::string>(
+                [i] { return std::string(static_cast<std::size_t>(i), 'x'); },
+                [&](std::string s) {
+                    onPollingThread = onPollingThread && std::this_thread::get_id() == self;
+                    sum += static_cast<int>(s.size());
+                    delivered++;
+                });
+    }
+
+    // nothing is handed over without poll()
+    REQUIRE(delivered == 0);
+
+    drain(loader);
+    REQUIRE(loader.idle());
+    REQUIRE(delivered == 20);
+    REQUIRE(sum == 210);
+    REQUIRE(onPollingThread);
+}
+
+TEST_CASE("AssetLoader poll respects its budget and survives failing work") {
+
+    AssetLoader loader(2);
+    int delivered = 0;
+
+    for (int i = 0; i < 6; ++i) {
+        loader.load<int>([i] {
+                             if (i == 3) throw std::runtime_error("missing file");
+                             return i;
+                         },
+                         [&](int) { delivered++; });
+    }
+
+    // wait for the failure, then take the five good ones two at a time
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (loader.failed() == 0 && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+
+    std::size_t ran = 0;
+    while (!loader.idle() && std::chrono::steady_clock::now() < deadline) {
+        const std::size_t n = loader.poll(2);
+        REQUIRE(n <= 2);
+        ran += n;
+    }
+
+    REQUIRE(ran == 5);
+    REQUIRE(delivered == 5);
+    REQUIRE(loader.failed() == 1);
+}
@@ -45,3 +45,26 @@ TEST_CASE("Car turns left/right when steering") {
 
     REQUIRE(car.rotation() != Approx(initialRot));
 }
+
+TEST_CASE("Car version changes only when the car visibly changes") {
+    Car car;
+    InputState idle{};
+
+    // parked: nothing to redraw
+    const auto parked = car.version();
+    car.update(1.f / 60.f, idle);
+    car.setPosition(0.f, 0.f);
+    REQUIRE(car.version() == parked);
+
+    InputState gas{};
+    gas.accelerate = true;
+    car.update(1.f / 60.f, gas);
+    REQUIRE(car.version() != parked);
+
+    // restoring an older state still counts as a change
+    const auto moved = car.version();
+    Car old;
+    car.restoreFrom(old);
+    REQUIRE(car.version() > moved);
+    REQUIRE(car.position().z == 0.f);
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+#include "ColliderBvh.hpp"
+#include "RayKernel.hpp"
+#include "World.hpp"
+
+TEST_CASE("Batched ray slab mask matches the scalar path") {
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> pos(-20, 20);
+    std::uniform_int_distribution<int> half(0, 5);
+    std::uniform_real_distribution<float> angle(-3.2f, 3.2f);
+
+    for (std::size_t count : {1u, 3u, 4u, 7u, 8u, 9u, 33u, 64u}) {
+        for (int q = 0; q < 200; ++q) {
+            RayFan rays;
+            // every fourth fan is a full circle from heading 0, with axis parallel rays
+            if (q % 4 == 0) rays.set(float(pos(rng)), float(pos(rng)), 0.f, 6.2831853f, count, 15.f);
+            else rays.set(float(pos(rng)), float(pos(rng)), angle(rng), 2.f, count, 15.f);
+
+            const float x = float(pos(rng)), z = float(pos(rng));
+            const float hw = float(half(rng)), hl = float(half(rng));
+            const GameObject::AABB box{x - hw, x + hw, z - hl, z + hl};
+
+            alignas(32) float simdEnter[RayFan::MaxRays];
+            alignas(32) float scalarEnter[RayFan::MaxRays];
+            const std::uint64_t simd = raySlabMask(rays, box, simdEnter);
+            const std::uint64_t scalar = raySlabMaskScalar(rays, box, scalarEnter);
+            REQUIRE(simd == scalar);
+            for (std::size_t k = 0; k < count; ++k) {
+                if ((scalar >> k) & 1u) REQUIRE(simdEnter[k] == scalarEnter[k]);
+            }
+            if (count < 64) REQUIRE((scalar >> count) == 0);
+        }
+    }
+}
+
+TEST_CASE("BVH ray casts match a brute force scan of the active obstacles") {
+
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> pos(-100.f, 100.f);
+    std::uniform_real_distribution<float> half(0.2f, 6.f);
+    std::uniform_real_distribution<float> angle(-3.2f, 3.2f);
+
+    ColliderStore colliders;
+    for (int i = 0; i < 600; ++i) {
+        const float x = pos(rng), z = pos(rng);
+        const float hw = half(rng), hl = half(rng);
+        colliders.add({x - hw, x + hw, z - hl, z + hl}, i % 5 == 0 ? ColliderKind::SpeedBoost : ColliderKind::Obstacle);
+    }
+    // some "opened gates": inactive obstacles stay in the tree
+    for (std::uint32_t i = 1; i < colliders.size(); i += 7) colliders.setActive(i, false);
+
+    ColliderBvh bvh;
+    bvh.build(colliders);
+    REQUIRE(bvh.size() == 480);
+
+    for (int q = 0; q < 200; ++q) {
+        RayFan rays;
+        rays.set(pos(rng), pos(rng), angle(rng), 6.2831853f, 64, 60.f);
+        RayFan brute = rays;
+
+        std::uint32_t hits[RayFan::MaxRays];
+        bvh.castRays(colliders, rays, hits);
+
+        alignas(32) float tEnter[RayFan::MaxRays];
+        for (std::uint32_t i = 0; i < colliders.size(); ++i) {
+            if (colliders.kind(i) != ColliderKind::Obstacle || !colliders.isActive(i)) continue;
+            std::uint64_t mask = raySlabMaskScalar(brute, colliders.bounds(i), tEnter);
+            for (std::size_t k = 0; k < brute.count; ++k) {
+                if ((mask >> k) & 1u) brute.t[k] = tEnter[k];
+            }
+        }
+
+        for (std::size_t k = 0; k < rays.count; ++k) {
+            REQUIRE(rays.t[k] == brute.t[k]);
+            REQUIRE((hits[k] == ColliderBvh::NoHit) == (rays.t[k] == 60.f));
+            if (hits[k] != ColliderBvh::NoHit) {
+                REQUIRE(colliders.kind(hits[k]) == ColliderKind::Obstacle);
+                REQUIRE(colliders.isActive(hits[k]));
+            }
+        }
+    }
+
+    // rebuilding the same store reuses every array
+    const std::size_t memory = bvh.memoryUsage();
+    bvh.build(colliders);
+    REQUIRE(bvh.memoryUsage() == memory);
+}
+
+TEST_CASE("Lidar sees a closed gate and looks through it once it opens") {
+
+    LevelFile level;
+    REQUIRE(level.loadText("start 0 0\n"
+                           "pickup 1 speed 0 6\n"
+                           "gate 1 0 20 4 1\n"
+                           "wall 0 40 10 1\n"));
+    World world(level.view());
+
+    auto ahead = [&] {
+        RayFan rays;
+        rays.set(0.f, 0.f, 0.f, 0.f, 1, 100.f);
+        std::uint32_t hit = 0;
+        world.castRays(rays, &hit);
+        return rays.t[0];
+    };
+
+    // pickups are not seen
+    REQUIRE(ahead() == 19.f);
+
+    InputState input;
+    input.accelerate = true;
+    for (int i = 0; i < 120 && !world.gateIsOpen(1); ++i) world.update(1.f / 60.f, input);
+    REQUIRE(world.gateIsOpen(1));
+    REQUIRE(ahead() == 39.f);
+
+    world.reset();
+    REQUIRE(ahead() == 19.f);
+}
@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "ColliderStore.hpp"
+#include "Obstacle.hpp"
+#include "World.hpp"
+
+TEST_CASE("ColliderStore keeps boxes, kinds and active flags") {
+
+    ColliderStore store;
+    for (int i = 0; i < 100; ++i) {
+        float x = float(i);
+        store.add({x, x + 1.f, 0.f, 2.f}, i % 2 ? ColliderKind::SpeedBoost : ColliderKind::Obstacle);
+    }
+
+    REQUIRE(store.size() == 100);
+    REQUIRE(store.minX()[70] == 70.f);
+    REQUIRE(store.maxX()[70] == 71.f);
+    REQUIRE(store.kind(70) == ColliderKind::Obstacle);
+    REQUIRE(store.kind(71) == ColliderKind::SpeedBoost);
+
+    REQUIRE(store.isActive(70));
+    store.setActive(70, false);
+    REQUIRE_FALSE(store.isActive(70));
+    REQUIRE(store.isActive(69));
+    REQUIRE(store.isActive(71));
+}
+
+TEST_CASE("Bound GameObject shares its active flag with the store") {
+
+    ColliderStore store;
+    Obstacle obstacle(0.f, 0.f, 1.f, 1.f);
+
+    auto i = store.add(obstacle.bounds(), ColliderKind::Obstacle);
+    store.bind(i, obstacle);
+
+    store.setActive(i, false);
+    REQUIRE_FALSE(obstacle.isActive());
+
+    store.setActive(i, true);
+    obstacle.deactivate();
+    REQUIRE_FALSE(store.isActive(i));
+}
+
+TEST_CASE("World objects view matches the collider store") {
+
+    World world;
+    auto objs = world.objects();
+    const auto& colliders = world.colliders();
+
+    REQUIRE(objs.size() == colliders.size());
+
+    for (std::uint32_t i = 0; i < objs.size(); ++i) {
+        auto b = objs[i]->bounds();
+        REQUIRE(b.minX == colliders.minX()[i]);
+        REQUIRE(b.maxZ == colliders.maxZ()[i]);
+        REQUIRE(objs[i]->isActive() == colliders.isActive(i));
+    }
+}
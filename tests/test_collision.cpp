@@ -86,3 +86,78 @@ TEST_CASE("Entering portal triggers portal state") {
     REQUIRE(world.portalTriggered());
 }
 
+TEST_CASE("Fast car does not tunnel through a thin wall with a large timestep") {
+
+    World world;
+
+    // heading +z towards the north border wall (z = 199 .. 201)
+    world.car().setPosition(0.f, 185.f);
+    world.car().applySpeedBoost();
+    world.car().setSpeed(50.f);
+
+    InputState input{};
+    input.accelerate = true;
+
+    // 50 m in one tick: the end position is well past the wall
+    world.update(1.f, input);
+
+    REQUIRE(world.car().position().z == Approx(199.f - world.car().getHalfLength()));
+    REQUIRE(world.car().speed() == 0.f);
+
+    bool contact = false;
+    for (const auto& e : world.events()) {
+        if (e.type == WorldEvent::Type::CollisionContact) contact = true;
+    }
+    REQUIRE(contact);
+}
+
+TEST_CASE("Car resting against a wall does not drive through it on a long tick") {
+
+    InputState input{};
+    input.accelerate = true;
+
+    for (float dt : {0.5f, 1.f}) {
+        for (float maxStep : {0.f, 2.f}) {
+            World world;
+            world.setSubstepping(maxStep);
+
+            // flush against the north border wall (z = 199 .. 201), standing still
+            world.car().setPosition(0.f, 199.f - world.car().getHalfLength());
+
+            for (int i = 0; i < 4; ++i) {
+                world.update(dt, input);
+                REQUIRE(world.car().position().z <= 199.f - world.car().getHalfLength());
+            }
+        }
+    }
+}
+
+TEST_CASE("Substepping splits a fast tick into equal steps") {
+
+    InputState input{};
+    input.accelerate = true;
+    input.turnLeft = true;
+
+    World stepped;
+    stepped.car().setSpeed(20.f);
+    stepped.setSubstepping(1.f);
+    stepped.update(0.25f, input);     // 5 m at the start speed, 5.9 m at the end speed -> 6 steps
+
+    World manual;
+    manual.car().setSpeed(20.f);
+    for (int i = 0; i < 6; ++i) manual.update(0.25f / 6.f, input);
+
+    REQUIRE(stepped.car().position().x == manual.car().position().x);
+    REQUIRE(stepped.car().position().z == manual.car().position().z);
+    REQUIRE(stepped.car().rotation() == manual.car().rotation());
+
+    // capped at maxSubsteps
+    World capped;
+    capped.car().setSpeed(20.f);
+    capped.setSubstepping(0.01f, 4);
+    World four;
+    four.car().setSpeed(20.f);
+    capped.update(0.2f, input);
+    for (int i = 0; i < 4; ++i) four.update(0.05f, input);
+    REQUIRE(capped.car().position().z == four.car().position().z);
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+#include "CollisionGrid.hpp"
+
+namespace {
+
+bool overlaps(const Car::AABB& a, const GameObject::AABB& b) {
+    return a.minX <= b.maxX && a.maxX >= b.minX &&
+           a.minZ <= b.maxZ && a.maxZ >= b.minZ;
+}
+
+}
+
+TEST_CASE("CollisionGrid finds the same overlaps as a full scan") {
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos(-200.f, 200.f);
+    std::uniform_real_distribution<float> half(0.5f, 30.f);
+
+    std::vector<GameObject::AABB> boxes;
+    ColliderStore store;
+    for (int i = 0; i < 500; ++i) {
+        float x = pos(rng), z = pos(rng), hw = half(rng), hl = half(rng);
+        boxes.push_back({x - hw, x + hw, z - hl, z + hl});
+        store.add(boxes.back(), ColliderKind::Obstacle);
+    }
+
+    CollisionGrid grid;
+    grid.build(store);
+
+    std::vector<std::uint32_t> candidates;
+
+    for (int q = 0; q < 200; ++q) {
+        float x = pos(rng), z = pos(rng);
+        Car::AABB car{x - 1.f, x + 1.f, z - 2.f, z + 2.f};
+
+        grid.query(car, candidates);
+
+        std::vector<std::uint32_t> expected;
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+            if (overlaps(car, boxes[i])) expected.push_back(i);
+        }
+
+        std::vector<std::uint32_t> hits;
+        for (auto i : candidates) {
+            if (overlaps(car, boxes[i])) hits.push_back(i);
+        }
+
+        REQUIRE(hits == expected);
+    }
+}
+
+TEST_CASE("CollisionGrid query outside the grid is empty") {
+
+    ColliderStore store;
+    store.add({0.f, 10.f, 0.f, 10.f}, ColliderKind::Obstacle);
+
+    CollisionGrid grid;
+    grid.build(store);
+
+    std::vector<std::uint32_t> candidates;
+    grid.query({100.f, 102.f, 100.f, 104.f}, candidates);
+
+    REQUIRE(candidates.empty());
+
+    grid.query({9.f, 11.f, 9.f, 13.f}, candidates);
+
+    REQUIRE(candidates.size() == 1);
+}
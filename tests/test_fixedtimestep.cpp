@@ -0,0 +1,36 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "FixedTimestep.hpp"
+
+using Catch::Approx;
+
+TEST_CASE("Fixed timestep runs one step per step-length of real time") {
+
+    FixedTimestep ts(1.0 / 60.0);
+
+    // 144 Hz display: 144 frames should give 60 simulation steps
+    int steps = 0;
+    for (int i = 0; i < 144; ++i) steps += ts.advance(1.0 / 144.0);
+
+    REQUIRE(steps == 60);
+    REQUIRE(ts.alpha() >= 0.f);
+    REQUIRE(ts.alpha() < 1.f);
+}
+
+TEST_CASE("Fixed timestep keeps the leftover as interpolation alpha") {
+
+    FixedTimestep ts(0.1);
+
+    REQUIRE(ts.advance(0.25) == 2);
+    REQUIRE(ts.alpha() == Approx(0.5f));
+}
+
+TEST_CASE("Fixed timestep caps substeps after a long hitch") {
+
+    FixedTimestep ts(1.0 / 60.0, 5);
+
+    REQUIRE(ts.advance(2.0) == 5);
+    REQUIRE(ts.droppedSeconds() > 1.5);
+    REQUIRE(ts.advance(0.0) == 0);
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "FastMath.hpp"
+#include "World.hpp"
+
+using Catch::Approx;
+
+TEST_CASE("Batched sin/cos matches std::sin and std::cos") {
+
+    std::vector<float> angles;
+    for (int i = -2000; i <= 2000; ++i) angles.push_back(float(i) * 0.01f);
+
+    std::vector<float> s(angles.size()), c(angles.size());
+    sinCosBatch(angles.data(), s.data(), c.data(), angles.size());
+
+    for (std::size_t i = 0; i < angles.size(); ++i) {
+        REQUIRE(s[i] == Approx(std::sin(angles[i])).margin(1e-6));
+        REQUIRE(c[i] == Approx(std::cos(angles[i])).margin(1e-6));
+    }
+}
+
+TEST_CASE("Traffic cars drive around the world") {
+
+    World world;
+    world.spawnTraffic(200, 3);
+
+    REQUIRE(world.traffic().size() == 200);
+
+    std::vector<Vec2> start;
+    for (std::size_t i = 0; i < world.traffic().size(); ++i) {
+        start.push_back(world.traffic().position(i));
+    }
+
+    InputState input{};
+    for (int t = 0; t < 120; ++t) world.update(1.f / 60.f, input);
+
+    int moved = 0;
+    for (std::size_t i = 0; i < world.traffic().size(); ++i) {
+        auto p = world.traffic().position(i);
+        if (std::abs(p.x - start[i].x) + std::abs(p.z - start[i].z) > 1.f) moved++;
+    }
+
+    REQUIRE(moved > 100);
+}
+
+TEST_CASE("Traffic cars do not end a tick overlapping the player") {
+
+    World world;
+    world.spawnTraffic(500, 11);
+
+    InputState input{};
+    input.accelerate = true;
+
+    for (int t = 0; t < 300; ++t) {
+        world.update(1.f / 60.f, input);
+
+        auto p = world.car().bounds();
+        for (std::size_t i = 0; i < world.traffic().size(); ++i) {
+            auto b = world.traffic().bounds(i);
+            bool overlap = p.minX < b.maxX - 1e-3f && p.maxX > b.minX + 1e-3f &&
+                           p.minZ < b.maxZ - 1e-3f && p.maxZ > b.minZ + 1e-3f;
+            REQUIRE_FALSE(overlap);
+        }
+    }
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "InputRecording.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+TEST_CASE("Recording run-length encodes the input stream") {
+
+    InputRecording rec;
+    rec.begin(1.f / 60.f, 0);
+
+    InputState gas{};
+    gas.accelerate = true;
+    InputState left = gas;
+    left.turnLeft = true;
+
+    for (int i = 0; i < 500; ++i) rec.record(gas);
+    for (int i = 0; i < 20; ++i) rec.record(left);
+    rec.markReset();
+    rec.record(gas);
+
+    REQUIRE(rec.tickCount() == 521);
+    REQUIRE(rec.runs().size() == 3);
+    REQUIRE(rec.runs()[0].ticks == 500);
+    REQUIRE(rec.runs()[1].keys == (InputRecording::Accelerate | InputRecording::TurnLeft));
+    REQUIRE(rec.runs()[2].keys == (InputRecording::Accelerate | InputRecording::Reset));
+
+    const InputState back = InputRecording::unpack(rec.runs()[1].keys);
+    REQUIRE(back.accelerate);
+    REQUIRE(back.turnLeft);
+    REQUIRE_FALSE(back.turnRight);
+}
+
+TEST_CASE("Recorded run replays to the same checksum from a file") {
+
+    const float dt = 1.f / 60.f;
+    const auto& level = LevelFile::defaultLevel().view();
+
+    Game live(level);
+    InputRecording rec;
+    rec.begin(dt, level.hash());
+
+    // some driving, a reset, and more driving
+    for (int i = 0; i < 900; ++i) {
+        InputState in{};
+        in.accelerate = (i / 100) % 3 != 2;
+        in.turnLeft = (i / 70) % 4 == 1;
+        in.turnRight = (i / 90) % 5 == 3;
+        if (i == 600) {
+            live.reset();
+            rec.markReset();
+        }
+        rec.record(in);
+        live.update(dt, in);
+    }
+    rec.finish(live.world());
+
+    const auto path = (std::filesystem::temp_directory_path() / "bilsim_test_recording.brec").string();
+    REQUIRE(rec.save(path));
+
+    InputRecording loaded;
+    REQUIRE(loaded.load(path));
+    std::remove(path.c_str());
+
+    REQUIRE(loaded.tickCount() == 900);
+    REQUIRE(loaded.levelHash() == level.hash());
+    REQUIRE(loaded.checksum() == stateChecksum(live.world()));
+
+    Game replayed(level);
+    REQUIRE(loaded.replay(replayed));
+    REQUIRE(replayed.world().car().position().x == live.world().car().position().x);
+    REQUIRE(replayed.world().car().position().z == live.world().car().position().z);
+}
+
+TEST_CASE("Recording carries the substepping of the run") {
+
+    const float dt = 1.f / 15.f;
+    const auto& level = LevelFile::defaultLevel().view();
+
+    Game live(level);
+    live.world().setSubstepping(0.5f, 4);
+    InputRecording rec;
+    rec.begin(dt, level.hash(), 0, 1, live.world().maxStepDistance(), live.world().maxSubsteps());
+
+    InputState in{};
+    in.accelerate = true;
+    for (int i = 0; i < 300; ++i) {
+        in.turnLeft = (i / 40) % 3 == 1;
+        rec.record(in);
+        live.update(dt, in);
+    }
+    rec.finish(live.world());
+
+    const auto path = (std::filesystem::temp_directory_path() / "bilsim_test_substeps.brec").string();
+    REQUIRE(rec.save(path));
+    InputRecording loaded;
+    REQUIRE(loaded.load(path));
+    std::remove(path.c_str());
+
+    REQUIRE(loaded.maxStepDistance() == 0.5f);
+    REQUIRE(loaded.maxSubsteps() == 4);
+
+    // the replaying game starts without substepping: the recording sets it
+    Game replayed(level);
+    REQUIRE(replayed.world().maxStepDistance() == 0.f);
+    REQUIRE(loaded.replay(replayed));
+    REQUIRE(replayed.world().maxStepDistance() == 0.5f);
+
+    // the same input without it ends somewhere else
+    InputRecording unsplit;
+    unsplit.begin(dt, level.hash());
+    for (int i = 0; i < 300; ++i) {
+        in.turnLeft = (i / 40) % 3 == 1;
+        unsplit.record(in);
+    }
+    Game plain(level);
+    std::uint64_t sum = 0;
+    unsplit.replay(plain, &sum);
+    REQUIRE(sum != loaded.checksum());
+}
+
+TEST_CASE("Corrupt recording headers are rejected") {
+
+    InputRecording rec;
+    rec.begin(1.f / 60.f, 0);
+    InputState gas{};
+    gas.accelerate = true;
+    for (int i = 0; i < 50; ++i) rec.record(gas);
+
+    const auto path = (std::filesystem::temp_directory_path() / "bilsim_test_corrupt.brec").string();
+    REQUIRE(rec.save(path));
+
+    std::string original;
+    {
+        std::ifstream in(path, std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(in), {});
+    }
+
+    // header field at offset, then load the patched file
+    auto loadPatched = [&](std::size_t offset, std::uint32_t value, std::string& error) {
+        std::string bytes = original;
+        std::memcpy(bytes.data() + offset, &value, sizeof(value));
+        std::ofstream(path, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        InputRecording loaded;
+        return loaded.load(path, &error);
+    };
+
+    std::string error;
+    REQUIRE_FALSE(loadPatched(20, 0xFFFFFFFFu, error));    // runCount
+    REQUIRE(error.find("truncated") != std::string::npos);
+    REQUIRE_FALSE(loadPatched(24, 51, error));             // tickCount
+    REQUIRE(error.find("tick count") != std::string::npos);
+    REQUIRE_FALSE(loadPatched(12, 0x7FFFFFFFu, error));    // trafficCount
+    REQUIRE(error.find("traffic") != std::string::npos);
+    REQUIRE(loadPatched(12, 0, error));
+
+    std::remove(path.c_str());
+}
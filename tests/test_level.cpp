@@ -0,0 +1,198 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Level.hpp"
+#include "World.hpp"
+#include "InputState.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+TEST_CASE("Level text compiles to the binary layout") {
+
+    std::vector<std::byte> bytes;
+    std::string error;
+    REQUIRE(compileLevel("start 1 2\n"
+                         "portal 10 20 3 4   # comment\n"
+                         "pickup 1 speed 5 6\n"
+                         "fence 0 -5 2 0.5\n"
+                         "gate 1 0 8 4 1\n", bytes, &error));
+
+    LevelView level;
+    REQUIRE(LevelView::parse(bytes, level, &error));
+
+    const auto& h = level.header();
+    REQUIRE(h.startX == 1.f);
+    REQUIRE(h.startZ == 2.f);
+    REQUIRE(h.portalHalfL == 4.f);
+    REQUIRE(h.gateCount == 1);
+
+    auto entities = level.entities();
+    REQUIRE(entities.size() == 3);
+    REQUIRE(entities[0].kind == LevelEntityKind::SpeedBoost);
+    REQUIRE(entities[0].gate == 1);
+    REQUIRE(entities[1].kind == LevelEntityKind::Fence);
+    REQUIRE(entities[1].halfL == 0.5f);
+    REQUIRE(entities[2].kind == LevelEntityKind::Gate);
+
+    REQUIRE_FALSE(compileLevel("wall 0 0 1\n", bytes, &error));
+    REQUIRE(error.find("line 1") != std::string::npos);
+    REQUIRE_FALSE(compileLevel("\n\ntree 0 0\n", bytes, &error));
+    REQUIRE(error.find("line 3") != std::string::npos);
+}
+
+TEST_CASE("Binary level file is mapped and loads into World") {
+
+    std::vector<std::byte> bytes;
+    REQUIRE(compileLevel("pickup 1 speed 0 10\n"
+                         "gate 1 0 30 4 1\n", bytes));
+
+    const auto path = (std::filesystem::temp_directory_path() / "bilsim_test_level.blvl").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    {
+        LevelFile file;
+        REQUIRE(file.open(path));
+        REQUIRE(file.view().entities().size() == 2);
+
+        World w(file.view());
+        REQUIRE(w.objects().size() == 2);
+        REQUIRE(w.gateCount() == 1);
+        REQUIRE_FALSE(w.gateIsOpen(1));
+
+        // drive through the pickup: its gate opens
+        InputState input{};
+        input.accelerate = true;
+        for (int i = 0; i < 120 && !w.gateIsOpen(1); ++i) w.update(1.f / 60.f, input);
+
+        REQUIRE(w.gateIsOpen(1));
+        REQUIRE(w.allPickupsCollected());
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Default level matches the built-in world") {
+
+    const auto& level = LevelFile::defaultLevel().view();
+    REQUIRE(level.entities().size() > 0);
+    REQUIRE(level.header().gateCount == 3);
+
+    World w;
+    REQUIRE(w.objects().size() == level.entities().size());
+    REQUIRE(w.totalPickups() == 6);
+    REQUIRE(w.portalCenter().x == -150.f);
+}
+
+TEST_CASE("Trigger lines compile to a version 2 trigger table") {
+
+    std::vector<std::byte> bytes;
+    std::string error;
+    REQUIRE(compileLevel("pickup 1 speed 0 10\n"
+                         "pickup 2 size 0 20\n"
+                         "trigger 3 any 1 2\n"
+                         "trigger 4 2 1 2 3   # two of three\n"
+                         "gate 4 0 30 4 1\n", bytes, &error));
+
+    LevelView level;
+    REQUIRE(LevelView::parse(bytes, level, &error));
+    REQUIRE(level.header().version == 2);
+    REQUIRE(level.header().gateCount == 4);
+    REQUIRE(level.triggers().size() == 2);
+    REQUIRE(level.triggers()[0].need == 1);
+    REQUIRE(level.triggers()[1].need == 2);
+    REQUIRE(level.links().size() == 5);
+    REQUIRE(level.links()[2].from == 1);
+    REQUIRE(level.links()[2].to == 4);
+
+    // levels without triggers keep the version 1 layout
+    REQUIRE(LevelFile::defaultLevel().view().header().version == 1);
+
+    REQUIRE_FALSE(compileLevel("pickup 1 speed 0 0\ntrigger 2 all 2\n", bytes, &error));
+    REQUIRE(error.find("depends on itself") != std::string::npos);
+    REQUIRE_FALSE(compileLevel("pickup 1 speed 0 0\ntrigger 1 2\n", bytes, &error));
+    REQUIRE(error.find("line 2") != std::string::npos);
+    REQUIRE_FALSE(compileLevel("trigger 1 all\n", bytes, &error));
+    REQUIRE_FALSE(compileLevel("pickup 1 speed 0 0\ntrigger 1 some\n", bytes, &error));
+}
+
+TEST_CASE("Binary levels with bad entities are rejected") {
+
+    std::vector<std::byte> good;
+    REQUIRE(compileLevel("pickup 1 speed 0 10\n"
+                         "gate 1 0 30 4 1\n", good));
+
+    LevelView level;
+    std::string error;
+    auto entity = [](std::vector<std::byte>& bytes, std::size_t i) {
+        return reinterpret_cast<LevelEntity*>(bytes.data() + sizeof(LevelHeader)) + i;
+    };
+
+    std::vector<std::byte> bytes = good;
+    entity(bytes, 1)->gate = 0;
+    REQUIRE_FALSE(LevelView::parse(bytes, level, &error));
+    REQUIRE(error.find("gate without a number") != std::string::npos);
+
+    bytes = good;
+    entity(bytes, 1)->gate = 2;
+    REQUIRE_FALSE(LevelView::parse(bytes, level, &error));
+    REQUIRE(error.find("out of range") != std::string::npos);
+
+    bytes = good;
+    entity(bytes, 0)->gate = 200;
+    REQUIRE_FALSE(LevelView::parse(bytes, level, &error));
+
+    bytes = good;
+    entity(bytes, 0)->kind = static_cast<LevelEntityKind>(7);
+    REQUIRE_FALSE(LevelView::parse(bytes, level, &error));
+    REQUIRE(error.find("unknown entity kind") != std::string::npos);
+
+    // World and the door list allocate gateCount entries
+    bytes = good;
+    reinterpret_cast<LevelHeader*>(bytes.data())->gateCount = 100000;
+    REQUIRE_FALSE(LevelView::parse(bytes, level, &error));
+    REQUIRE(error.find("gate count out of range") != std::string::npos);
+
+    REQUIRE(LevelView::parse(good, level, &error));
+}
+
+TEST_CASE("Trigger graph opens gates from pickups and other triggers") {
+
+    LevelFile file;
+    REQUIRE(file.loadText("pickup 1 speed 0 10\n"
+                          "pickup 2 speed 0 20\n"
+                          "pickup 3 speed 60 60    # never taken\n"
+                          "trigger 4 all 1 2\n"
+                          "trigger 5 any 3 4\n"
+                          "trigger 6 all 3 5\n"
+                          "gate 5 0 45 4 1\n"
+                          "gate 6 20 45 4 1\n"));
+
+    World w(file.view());
+    REQUIRE(w.gateCount() == 6);
+    for (int g = 1; g <= 6; ++g) REQUIRE_FALSE(w.gateIsOpen(g));
+
+    InputState input{};
+    input.accelerate = true;
+    std::vector<std::uint32_t> opened;
+    for (int i = 0; i < 120 && !w.gateIsOpen(5); ++i) {
+        w.update(1.f / 60.f, input);
+        for (const auto& e : w.events()) {
+            if (e.type == WorldEvent::Type::GateOpened) opened.push_back(e.id);
+        }
+    }
+
+    // the second pickup fires 2, then 4 through its links, then 5
+    REQUIRE(opened == std::vector<std::uint32_t>{1, 2, 4, 5});
+    REQUIRE(w.gateIsOpen(5));
+    REQUIRE_FALSE(w.gateIsOpen(3));
+    REQUIRE_FALSE(w.gateIsOpen(6));   // still needs trigger 3
+
+    // a restore brings the counters back with the active bits
+    w.reset();
+    REQUIRE_FALSE(w.gateIsOpen(4));
+    REQUIRE_FALSE(w.gateIsOpen(5));
+}
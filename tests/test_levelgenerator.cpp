@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Level.hpp"
+#include "LevelGenerator.hpp"
+#include "World.hpp"
+
+TEST_CASE("Generated levels are reproducible per seed") {
+
+    LevelGenParams params;
+    params.obstacles = 500;
+    params.pickups = 40;
+    params.gates = 4;
+
+    std::vector<std::byte> a, b, c;
+    REQUIRE(generateLevel(params, a));
+    REQUIRE(generateLevel(params, b));
+    REQUIRE(a == b);
+
+    params.seed = 2;
+    REQUIRE(generateLevel(params, c));
+    REQUIRE(a != c);
+
+    std::string error;
+    params.gates = 256;
+    REQUIRE_FALSE(generateLevel(params, c, &error));
+    REQUIRE_FALSE(error.empty());
+}
+
+TEST_CASE("Generated level loads into a playable world") {
+
+    LevelGenParams params;
+    params.obstacles = 10000;
+    params.pickups = 300;
+    params.gates = 30;
+
+    std::vector<std::byte> bytes;
+    REQUIRE(generateLevel(params, bytes));
+
+    LevelFile level;
+    REQUIRE(level.load(std::move(bytes)));
+    REQUIRE(level.view().header().gateCount == 30);
+
+    World world(level.view());
+    REQUIRE(world.colliders().size() == 4 + 10000 + 300 + 30);
+    REQUIRE(world.totalPickups() == 300);
+    REQUIRE(world.gateCount() == 30);
+    REQUIRE_FALSE(world.gateIsOpen(1));
+    REQUIRE(world.memoryUsage() > world.colliders().size() * sizeof(float) * 4);
+
+    // the start is kept clear
+    REQUIRE(world.events().empty());
+    InputState idle{};
+    world.update(1.f / 60.f, idle);
+    REQUIRE(world.events().empty());
+    REQUIRE(world.car().position().x == 0.f);
+}
@@ -0,0 +1,33 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "LodPolicy.hpp"
+
+TEST_CASE("LodPolicy picks the level by distance and culls far objects") {
+
+    LodPolicy lod({100.f, 250.f, 600.f});
+
+    REQUIRE(lod.levels() == 3);
+    REQUIRE(lod.select(10.f, 0) == 0);
+    REQUIRE(lod.select(150.f, 0) == 1);
+    REQUIRE(lod.select(300.f, 0) == 2);
+    REQUIRE(lod.select(900.f, 0) == LodPolicy::Culled);
+    REQUIRE(lod.select(10.f, LodPolicy::Culled) == 0);
+}
+
+TEST_CASE("LodPolicy holds the level near a boundary") {
+
+    LodPolicy lod({100.f, 250.f}, 10.f);
+
+    // moving out: switches only 10 past the boundary
+    REQUIRE(lod.select(105.f, 0) == 0);
+    REQUIRE(lod.select(111.f, 0) == 1);
+
+    // moving back in: stays coarse until 10 inside
+    REQUIRE(lod.select(95.f, 1) == 1);
+    REQUIRE(lod.select(89.f, 1) == 0);
+
+    // culling has the same margin
+    REQUIRE(lod.select(255.f, 1) == 1);
+    REQUIRE(lod.select(245.f, LodPolicy::Culled) == LodPolicy::Culled);
+    REQUIRE(lod.select(239.f, LodPolicy::Culled) == 1);
+}
@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "MeshCache.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+// A quad and a triangle with two materials; the quad shares an edge
+// (same v/vt/vn) with itself only, the triangle reuses corner 1
+constexpr const char* Obj =
+        "mtllib test.mtl\n"
+        "v 0 0 0\nv 1 0 0\nv 1 0 1\nv 0 0 1 1 1 1\n"
+        "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+        "vn 0 1 0\n"
+        "usemtl red\n"
+        "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+        "usemtl plain\n"
+        "f -4/-4/-1 -2/-2/-1 -1/-1/-1\n";
+
+constexpr const char* Mtl =
+        "newmtl red\n"
+        "Kd 1 0 0\n"
+        "map_Kd Textures/colormap.png\n"
+        "newmtl plain\n";
+
+}
+
+TEST_CASE("OBJ text parses into indexed triangles and material groups") {
+
+    MeshData mesh;
+    std::string error;
+    REQUIRE(parseObj(Obj, Mtl, mesh, &error));
+
+    REQUIRE(mesh.vertexCount() == 4);     // the triangle reuses the quad's corners
+    REQUIRE(mesh.indices.size() == 9);    // quad as two triangles + one triangle
+    REQUIRE(mesh.normals.size() == 12);
+    REQUIRE(mesh.uvs.size() == 8);
+
+    REQUIRE(mesh.groups.size() == 2);
+    REQUIRE(mesh.groups[0].count == 6);
+    REQUIRE(mesh.groups[1].start == 6);
+    REQUIRE(mesh.materials[mesh.groups[0].material].name == "red");
+    REQUIRE(mesh.materials[mesh.groups[0].material].diffuse[1] == 0.f);
+    REQUIRE(mesh.materials[mesh.groups[0].material].diffuseMap == "Textures/colormap.png");
+    REQUIRE(mesh.materials[mesh.groups[1].material].diffuseMap.empty());
+
+    REQUIRE_FALSE(parseObj("v 0 0 0\nf 1 2 3\n", "", mesh, &error));
+    REQUIRE(error.find("line 2") != std::string::npos);
+}
+
+TEST_CASE("Mesh cache round-trips and rejects damaged bytes") {
+
+    MeshData mesh;
+    REQUIRE(parseObj(Obj, Mtl, mesh));
+
+    std::vector<std::byte> bytes;
+    writeMeshCache(mesh, 1234, bytes);
+
+    MeshView view;
+    REQUIRE(MeshView::parse(bytes, view));
+    REQUIRE(view.sourceHash() == 1234);
+    REQUIRE(std::vector<float>(view.positions().begin(), view.positions().end()) == mesh.positions);
+    REQUIRE(std::vector<float>(view.uvs().begin(), view.uvs().end()) == mesh.uvs);
+    REQUIRE(std::vector<std::uint32_t>(view.indices().begin(), view.indices().end()) == mesh.indices);
+    REQUIRE(view.groups().size() == 2);
+    REQUIRE(view.materialCount() == 2);
+    REQUIRE(view.materialName(0) == "red");
+    REQUIRE(view.materialMap(0) == "Textures/colormap.png");
+    REQUIRE(view.materialDiffuse(0)[0] == 1.f);
+
+    std::vector<std::byte> truncated(bytes.begin(), bytes.end() - 16);
+    REQUIRE_FALSE(MeshView::parse(truncated, view));
+
+    bytes[0] = std::byte{'X'};
+    REQUIRE_FALSE(MeshView::parse(bytes, view));
+}
+
+TEST_CASE("Mesh file writes the cache once and rebuilds it when the source changes") {
+
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "bilsim_test_meshcache";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "textures");
+
+    auto write = [](const fs::path& path, const std::string& text) {
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    };
+    write(dir / "test.obj", Obj);
+    write(dir / "test.mtl", Mtl);
+    write(dir / "textures" / "colormap.png", "png");
+
+    const std::string objPath = (dir / "test.obj").string();
+    const std::string cacheDir = (dir / "cache").string();
+
+    MeshFile first;
+    REQUIRE(first.open(objPath, cacheDir));
+    REQUIRE_FALSE(first.fromCache());
+    REQUIRE(fs::exists(dir / "cache" / "test.bmesh"));
+    // Textures/ in the MTL is found as textures/ on disk
+    REQUIRE(first.view().materialMap(0) == (dir / "textures" / "colormap.png").generic_string());
+
+    MeshFile second;
+    REQUIRE(second.open(objPath, cacheDir));
+    REQUIRE(second.fromCache());
+    REQUIRE(second.view().indices().size() == 9);
+
+    // a changed material file invalidates the cache
+    write(dir / "test.mtl", std::string(Mtl) + "Kd 0 0 1\n");
+    MeshFile third;
+    REQUIRE(third.open(objPath, cacheDir));
+    REQUIRE_FALSE(third.fromCache());
+    REQUIRE(third.view().materialDiffuse(1)[2] == 1.f);
+
+    // simplified levels are keyed on the level and simplifier as well: a
+    // level 1 file does not pass for level 2 (as after a cell size change)
+    const std::uint64_t objHash = objSourceHash(objPath);
+    MeshFile lod1;
+    REQUIRE(lod1.open(objPath, cacheDir, 1));
+    REQUIRE(lod1.view().sourceHash() == meshLodSourceHash(objHash, 1));
+    REQUIRE(meshLodSourceHash(objHash, 1) != objHash);
+    REQUIRE(meshLodSourceHash(objHash, 1) != meshLodSourceHash(objHash, 2));
+
+    fs::copy_file(dir / "cache" / "test.lod1.bmesh", dir / "cache" / "test.lod2.bmesh",
+                  fs::copy_options::overwrite_existing);
+    MeshFile lod2;
+    REQUIRE(lod2.open(objPath, cacheDir, 2));
+    REQUIRE_FALSE(lod2.fromCache());
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Simplified mesh merges close vertices and drops collapsed triangles") {
+
+    // a 1x1 grid of 4x4 quads, all with the same uv
+    MeshData grid;
+    const int n = 4;
+    for (int z = 0; z <= n; ++z) {
+        for (int x = 0; x <= n; ++x) {
+            grid.positions.insert(grid.positions.end(), {float(x) / n, 0.f, float(z) / n});
+            grid.normals.insert(grid.normals.end(), {0.f, 1.f, 0.f});
+            grid.uvs.insert(grid.uvs.end(), {0.5f, 0.5f});
+        }
+    }
+    for (int z = 0; z < n; ++z) {
+        for (int x = 0; x < n; ++x) {
+            const std::uint32_t a = z * (n + 1) + x, b = a + 1, c = a + n + 1, d = c + 1;
+            grid.indices.insert(grid.indices.end(), {a, c, b, b, c, d});
+        }
+    }
+    grid.groups.push_back({0, static_cast<std::uint32_t>(grid.indices.size()), 0});
+    grid.materials.push_back({"grid"});
+
+    MeshData same;
+    simplifyMesh(grid, 0.01f, same);
+    REQUIRE(same.vertexCount() == grid.vertexCount());
+    REQUIRE(same.indices.size() == grid.indices.size());
+
+    MeshData coarse;
+    simplifyMesh(grid, 0.5f, coarse);
+    REQUIRE(coarse.vertexCount() < grid.vertexCount());
+    REQUIRE(coarse.indices.size() < grid.indices.size());
+    REQUIRE(coarse.normals.size() == coarse.positions.size());
+    REQUIRE(coarse.normals[1] == 1.f);
+    REQUIRE(coarse.groups.size() == 1);
+    REQUIRE(coarse.groups[0].count == coarse.indices.size());
+    for (std::uint32_t i : coarse.indices) REQUIRE(i < coarse.vertexCount());
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "LevelGenerator.hpp"
+#include "ObjectArena.hpp"
+#include "World.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts every global allocation of the test binary, so a test can check
+// that a piece of code does not touch the heap
+namespace {
+std::atomic<std::size_t> allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Tracked {
+    int value;
+    int* destroyed;
+    Tracked(int v, int* d) : value(v), destroyed(d) {}
+    ~Tracked() { (*destroyed)++; }
+};
+
+}
+
+TEST_CASE("Object arena places objects in creation order and reuses its block") {
+
+    int destroyed = 0;
+    ObjectArena arena;
+    arena.reserve(3 * ObjectArena::footprint<Tracked>());
+
+    Tracked* a = arena.create<Tracked>(1, &destroyed);
+    Tracked* b = arena.create<Tracked>(2, &destroyed);
+    Tracked* c = arena.create<Tracked>(3, &destroyed);
+    REQUIRE(c != nullptr);
+    REQUIRE(arena.create<Tracked>(4, &destroyed) == nullptr); // full
+    REQUIRE(arena.size() == 3);
+
+    // contiguous, one footprint apart
+    REQUIRE(reinterpret_cast<std::byte*>(b) - reinterpret_cast<std::byte*>(a) ==
+            static_cast<std::ptrdiff_t>(ObjectArena::footprint<Tracked>()));
+    REQUIRE(c->value == 3);
+
+    // moving the arena keeps the objects where they are
+    ObjectArena moved = std::move(arena);
+    REQUIRE(moved.size() == 3);
+    REQUIRE(arena.size() == 0);
+    REQUIRE(b->value == 2);
+
+    const std::size_t before = allocations.load();
+    moved.rewind();
+    REQUIRE(destroyed == 3);
+    moved.reserve(2 * ObjectArena::footprint<Tracked>());
+    REQUIRE(moved.create<Tracked>(5, &destroyed) == a); // same block, from the front
+    REQUIRE(allocations.load() == before);
+}
+
+TEST_CASE("World ticks, resets and reloads without heap allocations") {
+
+    // small and dense: the drive below collects pickups and hits fences
+    LevelGenParams params;
+    params.obstacles = 50;
+    params.pickups = 400;
+    params.gates = 8;
+    params.spacing = 6.f;
+    std::vector<std::byte> bytes;
+    REQUIRE(generateLevel(params, bytes));
+    LevelFile level;
+    REQUIRE(level.load(std::move(bytes)));
+
+    World world(level.view());
+    int collected = 0;
+    auto drive = [&] {
+        InputState input{};
+        input.accelerate = true;
+        for (int i = 0; i < 1800; ++i) {
+            input.turnLeft = (i / 90) % 3 == 0;
+            world.update(1.f / 60.f, input);
+        }
+        collected = world.collectedPickups();
+        world.reset();
+    };
+
+    // warm-up: event and hit buffers grow to their working size
+    drive();
+
+    const std::size_t before = allocations.load();
+    for (int round = 0; round < 3; ++round) drive();
+    const std::size_t ticks = allocations.load() - before;
+
+    // the same layout again: arena, colliders and grid keep their blocks
+    world.load(level.view());
+    const std::size_t reloadBefore = allocations.load();
+    world.load(level.view());
+    const std::size_t reload = allocations.load() - reloadBefore;
+
+    REQUIRE(collected > 0);
+    REQUIRE(ticks == 0);
+    REQUIRE(reload == 0);
+    REQUIRE(world.objects().size() == level.view().entities().size());
+}
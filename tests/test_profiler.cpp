@@ -0,0 +1,60 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Profiler.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+TEST_CASE("Profile scopes are recorded per thread and dumped as a Chrome trace") {
+
+    Profiler::clear();
+    Profiler::setEnabled(true);
+
+    {
+        ProfileScope outer("outer");
+        ProfileScope inner("inner");
+    }
+    std::thread worker([] {
+        Profiler::setThreadName("worker");
+        ProfileScope s("on worker");
+    });
+    worker.join();
+
+    REQUIRE(Profiler::eventCount() == 3);
+
+    const auto path = (std::filesystem::temp_directory_path() / "bilsim_test_trace.json").string();
+    REQUIRE(Profiler::writeChromeTrace(path));
+
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    in.close();
+    std::remove(path.c_str());
+
+    const std::string json = text.str();
+    REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"outer\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"on worker\"") != std::string::npos);
+    REQUIRE(json.find("\"args\":{\"name\":\"worker\"}") != std::string::npos);
+}
+
+TEST_CASE("Profiler ring keeps the newest scopes and can be switched off") {
+
+    Profiler::clear();
+
+    for (std::size_t i = 0; i < Profiler::RingSize + 100; ++i) {
+        Profiler::record("tick", i, i + 1);
+    }
+    REQUIRE(Profiler::eventCount() == Profiler::RingSize);
+
+    Profiler::clear();
+    Profiler::setEnabled(false);
+    {
+        ProfileScope s("ignored");
+    }
+    REQUIRE(Profiler::eventCount() == 0);
+    Profiler::setEnabled(true);
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "SimThread.hpp"
+#include "SpscQueue.hpp"
+#include "TripleBuffer.hpp"
+
+#include <array>
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("SPSC queue hands values across threads in order") {
+
+    SpscQueue<int, 8> queue;
+
+    // full at capacity
+    for (int i = 0; i < 8; ++i) REQUIRE(queue.push(i));
+    REQUIRE_FALSE(queue.push(8));
+    int value = -1;
+    for (int i = 0; i < 8; ++i) {
+        REQUIRE(queue.pop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(queue.pop(value));
+
+    const int count = 100000;
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i) {
+            while (!queue.push(i)) std::this_thread::yield();
+        }
+    });
+
+    int expected = 0;
+    while (expected < count) {
+        if (queue.pop(value)) {
+            REQUIRE(value == expected);
+            expected++;
+        }
+    }
+    producer.join();
+    REQUIRE(queue.size() == 0);
+}
+
+TEST_CASE("Triple buffer reader only sees whole, increasing values") {
+
+    // every element of a published value is the same number
+    using Value = std::array<int, 64>;
+    TripleBuffer<Value> buffer;
+
+    REQUIRE_FALSE(buffer.fetch());
+
+    const int count = 20000;
+    std::thread writer([&] {
+        for (int i = 1; i <= count; ++i) {
+            buffer.back().fill(i);
+            buffer.publish();
+        }
+    });
+
+    int last = 0;
+    while (last < count) {
+        if (!buffer.fetch()) continue;
+        const Value& v = buffer.front();
+        for (int x : v) REQUIRE(x == v[0]);
+        REQUIRE(v[0] > last);
+        last = v[0];
+    }
+    writer.join();
+    REQUIRE_FALSE(buffer.fetch());
+}
+
+TEST_CASE("Simulation thread runs the game from queued input and publishes frames") {
+
+    Game game;
+    SimThread sim(game, 1.0 / 240.0);
+
+    // a frame exists before the thread starts
+    const float startZ = sim.frame().car.z;
+    REQUIRE(sim.frame().tick == 0);
+
+    InputState input{};
+    input.accelerate = true;
+    REQUIRE(sim.setInput(input));
+    sim.start();
+
+    auto waitFor = [&](auto done) {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (std::chrono::steady_clock::now() < deadline) {
+            sim.fetch();
+            if (done(sim.frame())) return true;
+            std::this_thread::sleep_for(1ms);
+        }
+        return false;
+    };
+
+    REQUIRE(waitFor([&](const SimFrame& f) { return f.tick > 10 && f.car.z != startZ; }));
+    REQUIRE(sim.alpha(std::chrono::steady_clock::now()) <= 1.f);
+
+    REQUIRE(sim.setInput({}));
+    REQUIRE(sim.reset());
+    REQUIRE(waitFor([](const SimFrame& f) { return f.resets == 1; }));
+
+    sim.stop();
+    REQUIRE_FALSE(sim.running());
+
+    // the input was released before the reset, so the car stays where it restarted
+    REQUIRE(sim.frame().car.z == startZ);
+    REQUIRE(sim.frame().car.speed == 0.f);
+    REQUIRE_FALSE(sim.frame().active.empty());
+}
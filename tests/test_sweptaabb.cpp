@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "SweptAabb.hpp"
+
+using Catch::Approx;
+
+TEST_CASE("Swept box reports the time and axis of first contact") {
+
+    // 2x4 car moving 20 m along +z towards a 1 m thick wall at z = 10
+    const Car::AABB car{-1.f, 1.f, -2.f, 2.f};
+    const GameObject::AABB wall{-50.f, 50.f, 9.5f, 10.5f};
+
+    SweepHit hit;
+    REQUIRE(sweepAabb(car, 0.f, 20.f, wall, hit));
+    REQUIRE(hit.enter == Approx(7.5f / 20.f));
+    REQUIRE(hit.exit == Approx(12.5f / 20.f));
+    REQUIRE(hit.axis == 1);
+
+    // diagonal: the x face is reached first
+    const GameObject::AABB post{5.f, 6.f, -20.f, 20.f};
+    REQUIRE(sweepAabb(car, 10.f, 3.f, post, hit));
+    REQUIRE(hit.enter == Approx(0.4f));
+    REQUIRE(hit.axis == 0);
+}
+
+TEST_CASE("Swept box misses, stops short and starts inside") {
+
+    const Car::AABB car{-1.f, 1.f, -2.f, 2.f};
+    const GameObject::AABB wall{-50.f, 50.f, 9.5f, 10.5f};
+
+    SweepHit hit;
+    REQUIRE_FALSE(sweepAabb(car, 0.f, 5.f, wall, hit));    // stops 2.5 m short
+    REQUIRE_FALSE(sweepAabb(car, 0.f, -20.f, wall, hit));  // moving away
+    REQUIRE_FALSE(sweepAabb(car, 60.f, 0.f, wall, hit));   // parallel
+
+    const GameObject::AABB under{-0.5f, 0.5f, -0.5f, 0.5f};
+    REQUIRE(sweepAabb(car, 0.f, 20.f, under, hit));
+    REQUIRE(hit.enter < 0.f);
+    REQUIRE(hit.axis == -1);
+}
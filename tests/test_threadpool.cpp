@@ -0,0 +1,47 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+TEST_CASE("ThreadPool runs every submitted task") {
+
+    ThreadPool pool(4);
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&] { counter++; });
+    }
+    pool.wait();
+
+    REQUIRE(counter == 1000);
+}
+
+TEST_CASE("ThreadPool parallelFor visits each index exactly once") {
+
+    ThreadPool pool(3);
+    std::vector<std::atomic<int>> hits(997);
+
+    pool.parallelFor(hits.size(), 16, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) hits[i]++;
+    });
+
+    for (auto& h : hits) {
+        REQUIRE(h == 1);
+    }
+}
+
+TEST_CASE("ThreadPool supports nested parallelFor") {
+
+    ThreadPool pool(2);
+    std::atomic<int> counter{0};
+
+    pool.parallelFor(8, 1, [&](std::size_t, std::size_t) {
+        pool.parallelFor(10, 3, [&](std::size_t begin, std::size_t end) {
+            counter += int(end - begin);
+        });
+    });
+
+    REQUIRE(counter == 80);
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "VecEnv.hpp"
+
+#include <vector>
+
+TEST_CASE("Vector env steps every world with its own action") {
+
+    VecEnv::Config config;
+    config.batch = 64;
+    config.threads = 4;
+    VecEnv env(LevelFile::defaultLevel().view(), config);
+
+    REQUIRE(env.batch() == 64);
+    REQUIRE(env.observations().size() == 64 * VecEnv::ObsSize);
+    const float startZ = env.world(0).car().position().z;
+
+    // even worlds drive, odd worlds stand still
+    std::vector<std::uint8_t> actions(env.batch());
+    for (std::size_t i = 0; i < actions.size(); i += 2) actions[i] = VecEnv::Accelerate;
+    for (int s = 0; s < 30; ++s) env.step(actions);
+
+    for (std::size_t i = 0; i < env.batch(); ++i) {
+        const float* o = env.observations().data() + i * VecEnv::ObsSize;
+        if (i % 2 == 0) {
+            REQUIRE(env.world(i).car().position().z > startZ);
+            REQUIRE(o[VecEnv::Speed] > 0.f);
+        } else {
+            REQUIRE(env.world(i).car().position().z == startZ);
+            REQUIRE(o[VecEnv::Speed] == 0.f);
+        }
+        REQUIRE(o[VecEnv::PickupsLeft] == 1.f);
+        REQUIRE(env.dones()[i] == 0);
+    }
+
+    // the same actions on one thread give the same worlds
+    config.threads = 1;
+    VecEnv serial(LevelFile::defaultLevel().view(), config);
+    for (int s = 0; s < 30; ++s) serial.step(actions);
+    REQUIRE(serial.observations()[VecEnv::PosZ] == env.observations()[VecEnv::PosZ]);
+
+    // masked reset: only world 0 starts over
+    std::vector<std::uint8_t> mask(env.batch(), 0);
+    mask[0] = 1;
+    env.reset(mask);
+    REQUIRE(env.world(0).car().position().z == startZ);
+    REQUIRE(env.world(2).car().position().z > startZ);
+}
+
+TEST_CASE("Vector env rewards pickups and ends episodes") {
+
+    LevelFile level;
+    REQUIRE(level.loadText("pickup 0 speed 0 10\n"
+                           "portal 0 40 4 2\n"));
+
+    VecEnv::Config config;
+    config.batch = 2;
+    config.threads = 1;
+    config.maxSteps = 200;
+    config.progressReward = 0.f;
+    VecEnv env(level.view(), config);
+
+    const std::vector<std::uint8_t> drive{VecEnv::Accelerate, 0};
+    float reward = 0.f;
+    int steps = 0;
+    while (!env.dones()[0] && steps < 200) {
+        env.step(drive);
+        reward += env.rewards()[0];
+        steps++;
+    }
+
+    // pickup, then the portal (which ends the episode before maxSteps)
+    REQUIRE(env.dones()[0] == 1);
+    REQUIRE(steps < 200);
+    REQUIRE(reward == config.pickupReward + config.portalReward);
+
+    // auto reset: world 0 already restarted, world 1 runs into maxSteps
+    REQUIRE(env.observations()[VecEnv::PickupsLeft] == 1.f);
+    while (!env.dones()[1]) env.step(drive);
+    REQUIRE(env.world(1).car().speed() == 0.f);
+}
+
+TEST_CASE("Vector env appends lidar distances to the observations") {
+
+    LevelFile level;
+    REQUIRE(level.loadText("start 0 0\n"
+                           "wall 0 10 20 1\n"));
+
+    VecEnv::Config config;
+    config.batch = 3;
+    config.threads = 1;
+    config.lidarRays = 8;
+    config.lidarRange = 18.f;
+    VecEnv env(level.view(), config);
+
+    REQUIRE(env.obsSize() == VecEnv::ObsSize + 8);
+    REQUIRE(env.observations().size() == 3 * env.obsSize());
+
+    // full circle from straight ahead: ray 0 hits the wall at 9 m, ray 4
+    // looks backwards into nothing
+    const float* o = env.observations().data() + 2 * env.obsSize();
+    REQUIRE(o[VecEnv::Lidar] == 9.f / 18.f);
+    REQUIRE(o[VecEnv::Lidar + 4] == 1.f);
+}
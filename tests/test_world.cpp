@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include "World.hpp"
 #include "Car.hpp"
+#include "InputState.hpp"
 
 TEST_CASE("World initializes with objects") {
     World w;
@@ -18,3 +19,104 @@ TEST_CASE("World portal starts inactive") {
     World w;
     REQUIRE_FALSE(w.portalTriggered());
 }
+
+TEST_CASE("World reports collected pickups and contacts as events") {
+    World w;
+    InputState input{};
+    input.accelerate = true;
+
+    // straight ahead: speed boost at z = 90, then the closed castle gate
+    bool collected = false;
+    bool contact = false;
+    for (int i = 0; i < 1200 && !contact; ++i) {
+        w.update(1.f / 60.f, input);
+        for (const auto& e : w.events()) {
+            if (e.type == WorldEvent::Type::PickupCollected) {
+                collected = true;
+                REQUIRE_FALSE(w.objects()[e.id]->isActive());
+            }
+            if (e.type == WorldEvent::Type::CollisionContact) contact = true;
+        }
+    }
+
+    REQUIRE(collected);
+    REQUIRE(contact);
+    REQUIRE(w.collectedPickups() == 1);
+    REQUIRE(w.totalPickups() == 6);
+}
+
+TEST_CASE("World event buffer only holds the last update") {
+    World w;
+    InputState input{};
+    input.accelerate = true;
+
+    auto collectedNow = [&] {
+        for (const auto& e : w.events()) {
+            if (e.type == WorldEvent::Type::PickupCollected) return true;
+        }
+        return false;
+    };
+
+    int ticks = 0;
+    while (!collectedNow() && ticks++ < 1200) w.update(1.f / 60.f, input);
+    REQUIRE(collectedNow());
+
+    w.update(1.f / 60.f, input);
+    REQUIRE_FALSE(collectedNow());
+    REQUIRE(w.collectedPickups() == 1);
+
+    w.reset();
+    REQUIRE(w.events().empty());
+    REQUIRE(w.collectedPickups() == 0);
+}
+
+TEST_CASE("World restore rewinds car, pickups and traffic exactly") {
+    World w;
+    w.spawnTraffic(30, 5);
+
+    InputState input{};
+    input.accelerate = true;
+
+    auto saved = w.snapshot();
+
+    for (int i = 0; i < 400; ++i) w.update(1.f / 60.f, input);
+    const auto carAfter = w.car().position();
+    const auto trafficAfter = w.traffic().position(7);
+    const int collectedAfter = w.collectedPickups();
+    REQUIRE(collectedAfter > 0);
+
+    // rewind and play the same input again: same result, bit for bit
+    REQUIRE(w.restore(saved));
+    REQUIRE(w.collectedPickups() == 0);
+    REQUIRE(w.objects()[0]->isActive());
+
+    for (int i = 0; i < 400; ++i) w.update(1.f / 60.f, input);
+    REQUIRE(w.car().position().x == carAfter.x);
+    REQUIRE(w.car().position().z == carAfter.z);
+    REQUIRE(w.traffic().position(7).x == trafficAfter.x);
+    REQUIRE(w.traffic().position(7).z == trafficAfter.z);
+    REQUIRE(w.collectedPickups() == collectedAfter);
+
+    // snapshots only fit the layout they were taken from
+    World other;
+    REQUIRE_FALSE(other.restore(saved));
+}
+
+TEST_CASE("World reset restores state without rebuilding objects") {
+    World w;
+    const GameObject* first = w.objects()[0].get();
+
+    InputState input{};
+    input.accelerate = true;
+    for (int i = 0; i < 400; ++i) w.update(1.f / 60.f, input);
+    REQUIRE(w.collectedPickups() > 0);
+
+    const auto version = w.car().version();
+    w.reset();
+    REQUIRE(w.car().version() != version);
+    REQUIRE(w.objects()[0].get() == first);
+    REQUIRE(w.collectedPickups() == 0);
+    REQUIRE(w.car().position().z == 0.f);
+    REQUIRE(w.car().speed() == 0.f);
+    REQUIRE_FALSE(w.gate2IsOpen());
+}